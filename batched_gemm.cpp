@@ -0,0 +1,290 @@
+// batched_gemm.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "batched_gemm.hpp"
+#include "buffer_pool.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_gemm.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace {
+
+// One work-item multiplies one pair of matrices. The work-group first
+// copies its GROUP pairs into local memory with consecutive work-items
+// reading consecutive elements, and copies the products out the same way,
+// so global memory is never read with a stride of SIZE * SIZE between
+// neighbouring work-items. SIZE is a build option, so the loops unroll.
+const char* batchedKernelBody = R"(
+    #define NN (SIZE * SIZE)
+
+    __kernel void batchedMultiply(__global const TYPE* A,
+                                  const int strideA,
+                                  __global const TYPE* B,
+                                  const int strideB,
+                                  __global ACC* C,
+                                  const int count) {
+        __local TYPE localA[GROUP * NN];
+        __local TYPE localB[GROUP * NN];
+        __local ACC localC[GROUP * NN];
+
+        const int item = get_local_id(0);
+        const int first = get_group_id(0) * GROUP;
+        const int matrices = min(GROUP, count - first);
+
+        for (int e = item; e < matrices * NN; e += GROUP) {
+            const long matrix = first + e / NN;
+            localA[e] = A[matrix * strideA + e % NN];
+            localB[e] = B[matrix * strideB + e % NN];
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        if (item < matrices) {
+            const int base = item * NN;
+            #pragma unroll
+            for (int i = 0; i < SIZE; ++i) {
+                #pragma unroll
+                for (int j = 0; j < SIZE; ++j) {
+                    ACC sum = 0;
+                    #pragma unroll
+                    for (int k = 0; k < SIZE; ++k) {
+                        sum += (ACC)localA[base + i * SIZE + k] * (ACC)localB[base + k * SIZE + j];
+                    }
+                    localC[base + i * SIZE + j] = sum;
+                }
+            }
+        }
+        barrier(CLK_LOCAL_MEM_FENCE);
+
+        for (int e = item; e < matrices * NN; e += GROUP) {
+            C[(long)first * NN + e] = localC[e];
+        }
+    }
+)";
+
+// Largest n with a device kernel; its local arrays grow with n * n
+const int maximumDeviceSize = 8;
+
+// Largest number of matrices per work-group
+const int maximumGroup = 64;
+
+// Batches below this many multiply-adds run on one thread
+const double parallelWork = 1 << 15;
+
+template <typename T, typename Acc>
+const std::string& batchedSource() {
+    static const std::string source = openCLTypeDefines<T, Acc>() + batchedKernelBody;
+    return source;
+}
+
+// Multiplies matrices [begin, end) of the batch with the kernel for N
+template <typename T, typename Acc, int N>
+void multiplyRange(int begin, int end, const T* A, int strideA, const T* B, int strideB, Acc* C, int strideC) {
+    for (int m = begin; m < end; ++m) {
+        SmallGemm<T, Acc, N>::multiply(A + static_cast<size_t>(m) * strideA, B + static_cast<size_t>(m) * strideB,
+                                       C + static_cast<size_t>(m) * strideC);
+    }
+}
+
+template <typename T, typename Acc>
+void multiplyRange(int n, int begin, int end, const T* A, int strideA, const T* B, int strideB, Acc* C, int strideC) {
+    switch (n) {
+    case 1: multiplyRange<T, Acc, 1>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 2: multiplyRange<T, Acc, 2>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 3: multiplyRange<T, Acc, 3>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 4: multiplyRange<T, Acc, 4>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 5: multiplyRange<T, Acc, 5>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 6: multiplyRange<T, Acc, 6>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 7: multiplyRange<T, Acc, 7>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    case 8: multiplyRange<T, Acc, 8>(begin, end, A, strideA, B, strideB, C, strideC); return;
+    }
+    for (int m = begin; m < end; ++m) {
+        gemmCPU(n, n, n, A + static_cast<size_t>(m) * strideA, n, B + static_cast<size_t>(m) * strideB, n,
+                C + static_cast<size_t>(m) * strideC, n);
+    }
+}
+
+// Matrices per work-group: a power of two that fits the device's
+// work-group size and, with room to spare, its local memory
+template <typename T, typename Acc>
+int groupSize(OpenCLRuntime& runtime, int n) {
+    size_t maxItems = 0;
+    cl_ulong localBytes = 0;
+    clGetDeviceInfo(runtime.getDevice(), CL_DEVICE_MAX_WORK_GROUP_SIZE, sizeof(maxItems), &maxItems, nullptr);
+    clGetDeviceInfo(runtime.getDevice(), CL_DEVICE_LOCAL_MEM_SIZE, sizeof(localBytes), &localBytes, nullptr);
+    size_t bytesPerItem = static_cast<size_t>(n) * n * (2 * sizeof(T) + sizeof(Acc));
+
+    int group = maximumGroup;
+    while (group > 1 && (static_cast<size_t>(group) > maxItems || group * bytesPerItem > localBytes / 2)) {
+        group /= 2;
+    }
+    return group;
+}
+
+// Runs the batch on the device in launches sized to fit its largest
+// allocation. Returns false if anything fails.
+template <typename T, typename Acc>
+bool multiplyOnDevice(OpenCLRuntime& runtime, int n, int count, const T* A, int strideA, const T* B, int strideB,
+                      Acc* C, int strideC) {
+    const int group = groupSize<T, Acc>(runtime, n);
+    cl_kernel kernel = runtime.getKernel(batchedSource<T, Acc>(), "batchedMultiply",
+                                         "-DSIZE=" + std::to_string(n) + " -DGROUP=" + std::to_string(group));
+    if (kernel == nullptr) {
+        return false;
+    }
+
+    const size_t elements = static_cast<size_t>(n) * n;
+    cl_ulong maxAlloc = 0;
+    clGetDeviceInfo(runtime.getDevice(), CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(maxAlloc), &maxAlloc, nullptr);
+    size_t bytesPerMatrix = std::max({std::max<size_t>(strideA, elements) * sizeof(T),
+                                      std::max<size_t>(strideB, elements) * sizeof(T), elements * sizeof(Acc)});
+    // Pooled buffers round up by as much as a quarter
+    size_t chunk = std::max<size_t>(maxAlloc * 3 / 4 / bytesPerMatrix / group * group, group);
+
+    cl_command_queue queue = runtime.getQueue();
+    BufferPool& pool = runtime.getBufferPool();
+    for (int first = 0; first < count; first += static_cast<int>(chunk)) {
+        const int matrices = static_cast<int>(std::min<size_t>(chunk, count - first));
+        const size_t bytesA = ((matrices - 1) * static_cast<size_t>(strideA) + elements) * sizeof(T);
+        const size_t bytesB = ((matrices - 1) * static_cast<size_t>(strideB) + elements) * sizeof(T);
+        const size_t bytesC = matrices * elements * sizeof(Acc);
+
+        cl_mem bufferA = pool.acquire(bytesA);
+        cl_mem bufferB = pool.acquire(bytesB);
+        cl_mem bufferC = pool.acquire(bytesC);
+        cl_int error = bufferA && bufferB && bufferC ? CL_SUCCESS : CL_MEM_OBJECT_ALLOCATION_FAILURE;
+        PHY250_COUNT(BytesWritten, bytesA + bytesB);
+        if (error == CL_SUCCESS) {
+            error = clEnqueueWriteBuffer(queue, bufferA, CL_FALSE, 0, bytesA, A + static_cast<size_t>(first) * strideA,
+                                         0, nullptr, runtime.profileEvent(OpenCLRuntime::ProfileWrite));
+        }
+        if (error == CL_SUCCESS) {
+            error = clEnqueueWriteBuffer(queue, bufferB, CL_FALSE, 0, bytesB, B + static_cast<size_t>(first) * strideB,
+                                         0, nullptr, runtime.profileEvent(OpenCLRuntime::ProfileWrite));
+        }
+
+        if (error == CL_SUCCESS) {
+            std::lock_guard<std::mutex> guard(runtime.lock());
+            clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufferA);
+            clSetKernelArg(kernel, 1, sizeof(int), &strideA);
+            clSetKernelArg(kernel, 2, sizeof(cl_mem), &bufferB);
+            clSetKernelArg(kernel, 3, sizeof(int), &strideB);
+            clSetKernelArg(kernel, 4, sizeof(cl_mem), &bufferC);
+            clSetKernelArg(kernel, 5, sizeof(int), &matrices);
+
+            size_t localWorkSize = group;
+            size_t globalWorkSize = (matrices + group - 1) / group * static_cast<size_t>(group);
+            PHY250_COUNT(KernelLaunches, 1);
+            error = clEnqueueNDRangeKernel(queue, kernel, 1, nullptr, &globalWorkSize, &localWorkSize, 0, nullptr,
+                                           runtime.profileEvent(OpenCLRuntime::ProfileKernel));
+        }
+
+        Acc* destination = C + static_cast<size_t>(first) * strideC;
+        PHY250_COUNT(BytesRead, bytesC);
+        if (error == CL_SUCCESS && static_cast<size_t>(strideC) == elements) {
+            error = clEnqueueReadBuffer(queue, bufferC, CL_TRUE, 0, bytesC, destination, 0, nullptr,
+                                        runtime.profileEvent(OpenCLRuntime::ProfileRead));
+        } else if (error == CL_SUCCESS) {
+            // Scatter the packed products into the padded output
+            size_t origin[3] = {0, 0, 0};
+            size_t region[3] = {elements * sizeof(Acc), static_cast<size_t>(matrices), 1};
+            error = clEnqueueReadBufferRect(queue, bufferC, CL_TRUE, origin, origin, region,
+                                            elements * sizeof(Acc), 0, strideC * sizeof(Acc), 0, destination,
+                                            0, nullptr, runtime.profileEvent(OpenCLRuntime::ProfileRead));
+        }
+        if (error != CL_SUCCESS) {
+            clFinish(queue);
+        }
+        pool.release(bufferA);
+        pool.release(bufferB);
+        pool.release(bufferC);
+
+        if (error != CL_SUCCESS) {
+            std::cerr << "ERROR Running batched kernel" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+template <typename T, typename Acc>
+void gemmBatchedCPU(int n, int count,
+                    const T* A, int strideA,
+                    const T* B, int strideB,
+                    Acc* C, int strideC) {
+    if (n <= 0 || count <= 0) {
+        return;
+    }
+    if (strideA < 0 || strideB < 0 || strideC < n * n) {
+        std::cerr << "Error: Invalid strides for a batch of " << n << " x " << n << " matrices." << std::endl;
+        return;
+    }
+
+    PHY250_TIME_SCOPE("gemmBatchedCPU");
+    ThreadPool& pool = ThreadPool::instance();
+    if (pool.getThreadCount() == 1 || static_cast<double>(n) * n * n * count < parallelWork) {
+        multiplyRange(n, 0, count, A, strideA, B, strideB, C, strideC);
+        return;
+    }
+
+    // A few chunks per thread, so work stealing can even out the load
+    int chunks = std::min(count, pool.getThreadCount() * 4);
+    pool.parallelFor(chunks, [&](int chunk) {
+        int begin = static_cast<int>(static_cast<long long>(count) * chunk / chunks);
+        int end = static_cast<int>(static_cast<long long>(count) * (chunk + 1) / chunks);
+        multiplyRange(n, begin, end, A, strideA, B, strideB, C, strideC);
+    });
+}
+
+template <typename T, typename Acc>
+void gemmBatchedOpenCL(int n, int count,
+                       const T* A, int strideA,
+                       const T* B, int strideB,
+                       Acc* C, int strideC) {
+    if (n <= 0 || count <= 0) {
+        return;
+    }
+    if (strideA < 0 || strideB < 0 || strideC < n * n) {
+        std::cerr << "Error: Invalid strides for a batch of " << n << " x " << n << " matrices." << std::endl;
+        return;
+    }
+
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    if (n > maximumDeviceSize || !runtime.isAvailable()) {
+        gemmBatchedCPU(n, count, A, strideA, B, strideB, C, strideC);
+        return;
+    }
+    if (!OpenCLElement<T>::isSupported() || !OpenCLElement<Acc>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<T>::name() << " matrices." << std::endl;
+        gemmBatchedCPU(n, count, A, strideA, B, strideB, C, strideC);
+        return;
+    }
+
+    PHY250_TIME_SCOPE("gemmBatchedOpenCL");
+    if (!multiplyOnDevice(runtime, n, count, A, strideA, B, strideB, C, strideC)) {
+        std::cerr << "Error: Batched multiply failed on the device, using the CPU." << std::endl;
+        gemmBatchedCPU(n, count, A, strideA, B, strideB, C, strideC);
+    }
+}
+
+template void gemmBatchedCPU<float, float>(int, int, const float*, int, const float*, int, float*, int);
+template void gemmBatchedCPU<double, double>(int, int, const double*, int, const double*, int, double*, int);
+template void gemmBatchedCPU<int32_t, int32_t>(int, int, const int32_t*, int, const int32_t*, int, int32_t*, int);
+template void gemmBatchedCPU<int64_t, int64_t>(int, int, const int64_t*, int, const int64_t*, int, int64_t*, int);
+template void gemmBatchedCPU<int8_t, int32_t>(int, int, const int8_t*, int, const int8_t*, int, int32_t*, int);
+
+template void gemmBatchedOpenCL<float, float>(int, int, const float*, int, const float*, int, float*, int);
+template void gemmBatchedOpenCL<double, double>(int, int, const double*, int, const double*, int, double*, int);
+template void gemmBatchedOpenCL<int32_t, int32_t>(int, int, const int32_t*, int, const int32_t*, int, int32_t*, int);
+template void gemmBatchedOpenCL<int64_t, int64_t>(int, int, const int64_t*, int, const int64_t*, int, int64_t*, int);
+template void gemmBatchedOpenCL<int8_t, int32_t>(int, int, const int8_t*, int, const int8_t*, int, int32_t*, int);
@@ -0,0 +1,87 @@
+// batched_gemm.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef BATCHED_GEMM_HPP
+#define BATCHED_GEMM_HPP
+
+#include <cstring>
+
+// C = A * B for one N x N row-major matrix, with N known at compile time so
+// every loop unrolls. Products accumulate in Acc, as in gemmCPU.
+template <typename T, typename Acc, int N>
+struct SmallGemm {
+    static inline void multiply(const T* a, const T* b, Acc* c) {
+        for (int i = 0; i < N; ++i) {
+            for (int j = 0; j < N; ++j) {
+                Acc sum = 0;
+                for (int k = 0; k < N; ++k) {
+                    sum += static_cast<Acc>(a[i * N + k]) * static_cast<Acc>(b[k * N + j]);
+                }
+                c[i * N + j] = sum;
+            }
+        }
+    }
+};
+
+#if defined(__GNUC__)
+// With a power-of-two N and no widening, a row of B or C fits one SIMD
+// vector: row i of C is the sum over k of a[i][k] times row k of B.
+template <typename T, int N>
+struct SmallGemmRows {
+    typedef T Row __attribute__((vector_size(N * sizeof(T))));
+
+    static inline void multiply(const T* a, const T* b, T* c) {
+        Row rows[N];
+        for (int k = 0; k < N; ++k) {
+            std::memcpy(&rows[k], b + k * N, sizeof(Row));
+        }
+        for (int i = 0; i < N; ++i) {
+            Row sum = rows[0] * a[i * N];
+            for (int k = 1; k < N; ++k) {
+                sum += rows[k] * a[i * N + k];
+            }
+            std::memcpy(c + i * N, &sum, sizeof(Row));
+        }
+    }
+};
+
+template <typename T>
+struct SmallGemm<T, T, 2> : SmallGemmRows<T, 2> {
+};
+
+template <typename T>
+struct SmallGemm<T, T, 4> : SmallGemmRows<T, 4> {
+};
+#endif
+
+// C[i] = A[i] * B[i] for i in [0, count), where each operand is an n x n
+// row-major matrix and consecutive matrices of A, B and C start strideA,
+// strideB and strideC elements apart (n * n when packed back to back). A
+// stride of 0 uses the same matrix for every product, e.g. one rotation
+// applied to many vectors of matrices.
+//
+// n from 1 to 8 runs the SmallGemm kernel for that size; larger matrices
+// go through gemmCPU one at a time. Large batches are split over the
+// thread pool. strideC must be at least n * n. Instantiated for the same
+// types as gemmCPU.
+template <typename T, typename Acc>
+void gemmBatchedCPU(int n, int count,
+                    const T* A, int strideA,
+                    const T* B, int strideB,
+                    Acc* C, int strideC);
+
+// Same on the OpenCL device, in one launch per device allocation's worth of
+// matrices rather than one per product. Each work item computes one
+// product and each work-group stages its matrices through local memory, so
+// global memory is read and written in contiguous runs. Falls back to
+// gemmBatchedCPU if the device is unavailable, cannot run the type or n is
+// above 8.
+template <typename T, typename Acc>
+void gemmBatchedOpenCL(int n, int count,
+                       const T* A, int strideA,
+                       const T* B, int strideB,
+                       Acc* C, int strideC);
+
+#endif // BATCHED_GEMM_HPP
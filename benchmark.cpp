@@ -0,0 +1,406 @@
+// benchmark.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+// Times the multiply paths over a sweep of sizes, shapes, element types and
+// backends and prints the results as JSON. Run with --help for the options.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "matrix.hpp"
+#include "opencl_gemm.hpp"
+#include "thread_pool.hpp"
+
+namespace {
+
+struct Options {
+    std::vector<std::string> sizes = {"256", "512", "1024"};
+    std::vector<std::string> shapes = {"square", "tall", "wide", "deep"};
+    std::vector<std::string> types = {"float", "double", "int32", "int64", "int8"};
+    std::vector<std::string> backends = {"cpu", "strassen", "opencl", "opencl-resident", "async", "hybrid"};
+    int repeats = 5;
+    double cpuPeak = 0.0;
+    double devicePeak = 0.0;
+    std::string output;
+    std::string trace;
+};
+
+// rows x inner times inner x cols. Every shape of size n does n^3
+// multiply-adds, so their rates compare directly.
+struct Shape {
+    std::string name;
+    int rows;
+    int inner;
+    int cols;
+};
+
+bool makeShape(const std::string& name, int n, Shape& shape) {
+    shape.name = name;
+    if (name == "square") {
+        shape.rows = n, shape.inner = n, shape.cols = n;
+    } else if (name == "tall") {
+        shape.rows = 4 * n, shape.inner = n, shape.cols = n / 4;
+    } else if (name == "wide") {
+        shape.rows = n / 4, shape.inner = n, shape.cols = 4 * n;
+    } else if (name == "deep") {
+        shape.rows = n / 2, shape.inner = 4 * n, shape.cols = n / 2;
+    } else {
+        return false;
+    }
+    return shape.rows > 0 && shape.cols > 0;
+}
+
+bool isDeviceBackend(const std::string& backend) {
+    return backend != "cpu" && backend != "strassen";
+}
+
+std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::istringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+std::string jsonString(const std::string& text) {
+    std::string quoted = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            quoted += '\\';
+            quoted += c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            quoted += c;
+        }
+    }
+    return quoted + "\"";
+}
+
+// Negative values stand for unknown ones
+std::string jsonNumber(double value) {
+    if (!(value >= 0.0)) {
+        return "null";
+    }
+    std::ostringstream number;
+    number.precision(6);
+    number << value;
+    return number.str();
+}
+
+// Clock rate of CPU 0 in GHz, or 0 if the system does not say
+double cpuGigahertz() {
+    std::ifstream maxFrequency("/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_max_freq");
+    double kilohertz = 0.0;
+    if (maxFrequency >> kilohertz && kilohertz > 0.0) {
+        return kilohertz * 1e-6;
+    }
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+        if (line.compare(0, 7, "cpu MHz") == 0 && line.find(':') != std::string::npos) {
+            return std::atof(line.c_str() + line.find(':') + 1) * 1e-3;
+        }
+    }
+    return 0.0;
+}
+
+// Physical cores, counting each (package, core) pair once so SMT siblings
+// share their core; the hardware thread count if the system does not say
+int physicalCores() {
+    std::set<std::pair<int, int>> cores;
+    for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+        std::string topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+        std::ifstream package(topology + "physical_package_id");
+        std::ifstream core(topology + "core_id");
+        int packageId, coreId;
+        if (package >> packageId && core >> coreId) {
+            cores.insert({packageId, coreId});
+        }
+    }
+    return cores.empty() ? static_cast<int>(std::thread::hardware_concurrency()) : static_cast<int>(cores.size());
+}
+
+// Estimated CPU peak in GFLOP/s for Acc: every core the pool can use
+// retiring two fused multiply-adds per cycle on full vectors of the
+// selected microkernel. Integer GEMM has no fused multiply-add and its
+// vector multiplies are far slower, so there is no estimate for it (0).
+template <typename Acc>
+double estimateCPUPeak() {
+    if (!std::is_floating_point<Acc>::value) {
+        return 0.0;
+    }
+    std::string kernel = gemmCPUKernelName();
+    double lanes = kernel == "avx512" ? 64.0 / sizeof(Acc) : kernel == "avx2" ? 32.0 / sizeof(Acc) : 1.0;
+    int cores = std::min(ThreadPool::instance().getThreadCount(), physicalCores());
+    return cores * cpuGigahertz() * 2.0 * 2.0 * lanes;
+}
+
+template <typename T>
+Matrix<T> randomMatrix(int rows, int cols, std::mt19937& generator) {
+    // Small values keep int8 products and float sums exact
+    std::uniform_int_distribution<int> distribution(-8, 8);
+    Matrix<T> matrix(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+        T* row = matrix.row(i);
+        for (int j = 0; j < cols; ++j) {
+            row[j] = static_cast<T>(distribution(generator));
+        }
+    }
+    return matrix;
+}
+
+// Returns a function doing one multiply with the backend, ending with the
+// result on the host, or an empty function if the backend cannot run T
+template <typename T>
+std::function<bool()> makeRun(const std::string& backend, Matrix<T>& a, Matrix<T>& b) {
+    typedef typename Matrix<T>::ResultType ResultType;
+    if (backend == "cpu") {
+        return [&a, &b]() { return a.multiplyCPU(b).getRows() > 0; };
+    }
+    if (backend == "strassen") {
+        return [&a, &b]() { return a.multiplyStrassen(b).getRows() > 0; };
+    }
+    if (!OpenCLRuntime::instance().isAvailable() || !OpenCLElement<T>::isSupported() ||
+        !OpenCLElement<ResultType>::isSupported()) {
+        return std::function<bool()>();
+    }
+    if (backend == "opencl") {
+        // Writing through data() marks the device copies stale, so every
+        // run uploads both operands
+        return [&a, &b]() {
+            a.data();
+            b.data();
+            Matrix<ResultType> result = a.multiplyOpenCL(b);
+            result.download();
+            return result.getRows() > 0;
+        };
+    }
+    if (backend == "opencl-resident") {
+        return [&a, &b]() {
+            Matrix<ResultType> result = a.multiplyOpenCL(b);
+            result.download();
+            return result.getRows() > 0;
+        };
+    }
+    if (backend == "async") {
+        return [&a, &b]() { return a.multiplyOpenCLAsync(b).get().getRows() > 0; };
+    }
+    if (backend == "hybrid") {
+        return [&a, &b]() { return a.multiplyHybrid(b).getRows() > 0; };
+    }
+    return std::function<bool()>();
+}
+
+template <typename T>
+void runType(const std::string& type, const Options& options, std::vector<std::string>& results) {
+    typedef typename Matrix<T>::ResultType ResultType;
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    std::mt19937 generator(250);
+    const double cpuPeak = options.cpuPeak > 0.0 ? options.cpuPeak : estimateCPUPeak<ResultType>();
+
+    for (const std::string& size : options.sizes) {
+        for (const std::string& shapeName : options.shapes) {
+            Shape shape;
+            if (!makeShape(shapeName, std::atoi(size.c_str()), shape)) {
+                continue;
+            }
+            Matrix<T> a = randomMatrix<T>(shape.rows, shape.inner, generator);
+            Matrix<T> b = randomMatrix<T>(shape.inner, shape.cols, generator);
+
+            for (const std::string& backend : options.backends) {
+                std::function<bool()> run = makeRun<T>(backend, a, b);
+                // The first run builds programs, tunes and uploads; it is
+                // not timed and its profile is dropped
+                if (!run || !run()) {
+                    continue;
+                }
+                if (runtime.isAvailable()) {
+                    runtime.takeProfile();
+                }
+
+                std::vector<double> seconds;
+                for (int i = 0; i < options.repeats; ++i) {
+                    auto start = std::chrono::steady_clock::now();
+                    run();
+                    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+                    seconds.push_back(elapsed.count());
+                }
+                std::sort(seconds.begin(), seconds.end());
+
+                double flops = 2.0 * shape.rows * shape.inner * shape.cols;
+                double gflops = flops / seconds.front() * 1e-9;
+                double peak = !isDeviceBackend(backend) ? cpuPeak : backend != "hybrid" ? options.devicePeak
+                              : options.devicePeak > 0.0 ? cpuPeak + options.devicePeak : 0.0;
+
+                std::ostringstream result;
+                result << "    {\"backend\": " << jsonString(backend) << ", \"type\": " << jsonString(type)
+                       << ", \"shape\": " << jsonString(shape.name) << ", \"rows\": " << shape.rows
+                       << ", \"inner\": " << shape.inner << ", \"cols\": " << shape.cols
+                       << ", \"repeats\": " << options.repeats
+                       << ", \"best_seconds\": " << jsonNumber(seconds.front())
+                       << ", \"median_seconds\": " << jsonNumber(seconds[seconds.size() / 2])
+                       << ", \"gflops\": " << jsonNumber(gflops)
+                       << ", \"percent_of_peak\": " << jsonNumber(peak > 0.0 ? 100.0 * gflops / peak : -1.0);
+                if (isDeviceBackend(backend) && runtime.isProfiling()) {
+                    // Device times per run, summed over every queue
+                    OpenCLProfile profile = runtime.takeProfile();
+                    result << ", \"write_seconds\": " << jsonNumber(profile.writeSeconds / options.repeats)
+                           << ", \"kernel_seconds\": " << jsonNumber(profile.kernelSeconds / options.repeats)
+                           << ", \"read_seconds\": " << jsonNumber(profile.readSeconds / options.repeats);
+                }
+                result << "}";
+                results.push_back(result.str());
+                std::cerr << type << " " << shape.name << " " << shape.rows << "x" << shape.inner << "x" << shape.cols
+                          << " " << backend << ": " << gflops << " GFLOP/s" << std::endl;
+            }
+        }
+    }
+}
+
+void printUsage() {
+    std::cerr << "Usage: benchmark [options]\n"
+                 "  --sizes 256,512,1024       base sizes n\n"
+                 "  --shapes square,tall,wide,deep\n"
+                 "                             square n x n x n, tall 4n x n x n/4,\n"
+                 "                             wide n/4 x n x 4n, deep n/2 x 4n x n/2\n"
+                 "  --types float,double,int32,int64,int8\n"
+                 "  --backends cpu,strassen,opencl,opencl-resident,async,hybrid\n"
+                 "  --repeats 5                timed runs per case\n"
+                 "  --cpu-peak GFLOPS          CPU peak (default: estimated for float and double)\n"
+                 "  --device-peak GFLOPS       OpenCL device peak (default: unknown)\n"
+                 "  --output FILE              write JSON to FILE instead of stdout\n"
+                 "  --trace FILE               write a Chrome trace of the run to FILE\n"
+                 "                             (needs a -DPHY250_INSTRUMENT build)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--help" || i + 1 >= argc) {
+            printUsage();
+            return option == "--help" ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (option == "--sizes") {
+            options.sizes = splitList(value);
+        } else if (option == "--shapes") {
+            options.shapes = splitList(value);
+        } else if (option == "--types") {
+            options.types = splitList(value);
+        } else if (option == "--backends") {
+            options.backends = splitList(value);
+        } else if (option == "--repeats") {
+            options.repeats = std::max(1, std::atoi(value.c_str()));
+        } else if (option == "--cpu-peak") {
+            options.cpuPeak = std::atof(value.c_str());
+        } else if (option == "--device-peak") {
+            options.devicePeak = std::atof(value.c_str());
+        } else if (option == "--output") {
+            options.output = value;
+        } else if (option == "--trace") {
+            options.trace = value;
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Queues only record timestamps if profiling is on when they are
+    // created, so this has to come before the first OpenCL call
+    setenv("PHY250_CL_PROFILE", "1", 0);
+    Instrumentation& instrumentation = Instrumentation::instance();
+    if (!options.trace.empty()) {
+        if (!Instrumentation::isCompiledIn()) {
+            std::cerr << "Warning: Built without PHY250_INSTRUMENT, so the trace will be empty" << std::endl;
+        }
+        instrumentation.setTracing(true);
+    }
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+
+    std::vector<std::string> results;
+    for (const std::string& type : options.types) {
+        if (type == "float") {
+            runType<float>(type, options, results);
+        } else if (type == "double") {
+            runType<double>(type, options, results);
+        } else if (type == "int32") {
+            runType<int32_t>(type, options, results);
+        } else if (type == "int64") {
+            runType<int64_t>(type, options, results);
+        } else if (type == "int8") {
+            runType<int8_t>(type, options, results);
+        } else {
+            std::cerr << "Error: Unknown type " << type << std::endl;
+            return 1;
+        }
+    }
+
+    std::string device = "none";
+    if (runtime.isAvailable()) {
+        size_t size = 0;
+        clGetDeviceInfo(runtime.getDevice(), CL_DEVICE_NAME, 0, nullptr, &size);
+        std::vector<char> name(size + 1, '\0');
+        clGetDeviceInfo(runtime.getDevice(), CL_DEVICE_NAME, size, name.data(), nullptr);
+        device = name.data();
+    }
+
+    std::ostringstream json;
+    json << "{\n"
+         << "  \"device\": " << jsonString(device) << ",\n"
+         << "  \"cpu_kernel\": " << jsonString(gemmCPUKernelName()) << ",\n"
+         << "  \"threads\": " << ThreadPool::instance().getThreadCount() << ",\n"
+         << "  \"cpu_gigahertz\": " << jsonNumber(cpuGigahertz() > 0.0 ? cpuGigahertz() : -1.0) << ",\n"
+         << "  \"device_peak_gflops\": " << jsonNumber(options.devicePeak > 0.0 ? options.devicePeak : -1.0) << ",\n"
+         << "  \"profiling\": " << (runtime.isProfiling() ? "true" : "false") << ",\n";
+    if (Instrumentation::isCompiledIn()) {
+        Instrumentation::Snapshot snapshot = instrumentation.snapshot();
+        json << "  \"counters\": {";
+        for (int i = 0; i < Instrumentation::CounterCount; ++i) {
+            Instrumentation::Counter counter = static_cast<Instrumentation::Counter>(i);
+            json << (i > 0 ? ", " : "") << jsonString(Instrumentation::counterName(counter)) << ": "
+                 << snapshot.counters[i];
+        }
+        json << "},\n";
+    }
+    json << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        json << results[i] << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    json << "  ]\n}\n";
+
+    if (options.output.empty()) {
+        std::cout << json.str();
+    } else {
+        std::ofstream file(options.output);
+        file << json.str();
+        if (!file) {
+            std::cerr << "Error: Cannot write " << options.output << std::endl;
+            return 1;
+        }
+    }
+    if (!options.trace.empty() && !instrumentation.writeChromeTrace(options.trace)) {
+        std::cerr << "Error: Cannot write " << options.trace << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,280 @@
+// buffer_pool.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "buffer_pool.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+namespace {
+
+const size_t minimumClass = 4096;
+const size_t defaultLimitMegabytes = 256;
+
+size_t limitFromEnvironment(const char* name) {
+    const char* setting = std::getenv(name);
+    size_t megabytes = defaultLimitMegabytes;
+    if (setting != nullptr && *setting != '\0') {
+        megabytes = static_cast<size_t>(std::strtoull(setting, nullptr, 10));
+    }
+    return megabytes << 20;
+}
+
+void countAllocation(PoolStats& stats, size_t capacity) {
+    stats.bytesInUse += capacity;
+    stats.peakBytes = std::max(stats.peakBytes, stats.bytesInUse + stats.bytesCached);
+}
+
+} // namespace
+
+size_t poolSizeClass(size_t bytes) {
+    if (bytes <= minimumClass) {
+        return minimumClass;
+    }
+    size_t power = minimumClass;
+    while (power <= bytes / 2) {
+        power *= 2;
+    }
+    size_t step = power / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+BufferPool::BufferPool(OpenCLRuntime& runtime)
+    : runtime(runtime), stats(), limit(limitFromEnvironment("PHY250_CL_POOL_MB")) {
+}
+
+BufferPool::~BufferPool() {
+    trim();
+}
+
+cl_mem BufferPool::take(size_t capacity, bool staging, void** host) {
+    {
+        std::lock_guard<std::mutex> guard(poolMutex);
+        for (auto it = cached.rbegin(); it != cached.rend(); ++it) {
+            if (it->capacity == capacity && (it->host != nullptr) == staging) {
+                Block block = *it;
+                cached.erase(std::next(it).base());
+                inUse[block.buffer] = block;
+                stats.bytesCached -= capacity;
+                stats.bytesInUse += capacity;
+                ++stats.hits;
+                *host = block.host;
+                return block.buffer;
+            }
+        }
+    }
+
+    cl_int error;
+    cl_mem_flags flags = CL_MEM_READ_WRITE | (staging ? CL_MEM_ALLOC_HOST_PTR : 0);
+    Block block = {clCreateBuffer(runtime.getContext(), flags, capacity, nullptr, &error), nullptr, capacity};
+    if (block.buffer == nullptr) {
+        // The cache may be holding the memory this needs
+        trim();
+        block.buffer = clCreateBuffer(runtime.getContext(), flags, capacity, nullptr, &error);
+    }
+    if (block.buffer == nullptr) {
+        std::cerr << "ERROR Creating buffers" << std::endl;
+        return nullptr;
+    }
+    if (staging) {
+        // Mapped once for its whole life in the pool
+        block.host = clEnqueueMapBuffer(runtime.getQueue(), block.buffer, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE,
+                                        0, capacity, 0, nullptr, nullptr, &error);
+        if (block.host == nullptr) {
+            std::cerr << "ERROR Mapping staging buffer" << std::endl;
+            clReleaseMemObject(block.buffer);
+            return nullptr;
+        }
+    }
+
+    PHY250_COUNT(DeviceAllocations, 1);
+    PHY250_COUNT(AllocatedBytes, capacity);
+    std::lock_guard<std::mutex> guard(poolMutex);
+    inUse[block.buffer] = block;
+    ++stats.misses;
+    countAllocation(stats, capacity);
+    *host = block.host;
+    return block.buffer;
+}
+
+void BufferPool::give(const Block& block) {
+    std::lock_guard<std::mutex> guard(poolMutex);
+    stats.bytesInUse -= block.capacity;
+    if (block.capacity > limit) {
+        stats.trimmedBytes += block.capacity;
+        destroy(block);
+        return;
+    }
+    cached.push_back(block);
+    stats.bytesCached += block.capacity;
+    trimLocked(limit);
+}
+
+cl_mem BufferPool::acquire(size_t bytes) {
+    void* host;
+    return take(poolSizeClass(bytes), false, &host);
+}
+
+void BufferPool::release(cl_mem buffer) {
+    if (buffer == nullptr) {
+        return;
+    }
+    Block block;
+    {
+        std::lock_guard<std::mutex> guard(poolMutex);
+        auto it = inUse.find(buffer);
+        if (it == inUse.end()) {
+            std::cerr << "Error: Buffer was not acquired from this pool." << std::endl;
+            return;
+        }
+        block = it->second;
+        inUse.erase(it);
+    }
+    give(block);
+}
+
+StagingBuffer BufferPool::acquireStaging(size_t bytes) {
+    StagingBuffer staging;
+    staging.capacity = poolSizeClass(bytes);
+    staging.buffer = take(staging.capacity, true, &staging.host);
+    if (staging.buffer == nullptr) {
+        staging.host = nullptr;
+        staging.capacity = 0;
+    }
+    return staging;
+}
+
+void BufferPool::releaseStaging(const StagingBuffer& staging) {
+    release(staging.buffer);
+}
+
+PoolStats BufferPool::getStats() const {
+    std::lock_guard<std::mutex> guard(poolMutex);
+    return stats;
+}
+
+size_t BufferPool::getLimit() const {
+    std::lock_guard<std::mutex> guard(poolMutex);
+    return limit;
+}
+
+void BufferPool::setLimit(size_t bytes) {
+    std::lock_guard<std::mutex> guard(poolMutex);
+    limit = bytes;
+    trimLocked(limit);
+}
+
+void BufferPool::trim(size_t keepBytes) {
+    std::lock_guard<std::mutex> guard(poolMutex);
+    trimLocked(keepBytes);
+}
+
+void BufferPool::trimLocked(size_t keepBytes) {
+    while (stats.bytesCached > keepBytes && !cached.empty()) {
+        Block block = cached.front();
+        cached.pop_front();
+        stats.bytesCached -= block.capacity;
+        stats.trimmedBytes += block.capacity;
+        destroy(block);
+    }
+}
+
+void BufferPool::destroy(const Block& block) {
+    if (block.host != nullptr) {
+        clEnqueueUnmapMemObject(runtime.getQueue(), block.buffer, block.host, 0, nullptr, nullptr);
+    }
+    clReleaseMemObject(block.buffer);
+}
+
+HostArena& HostArena::instance() {
+    static HostArena* arena = new HostArena();
+    return *arena;
+}
+
+HostArena::HostArena() : stats(), limit(limitFromEnvironment("PHY250_HOST_POOL_MB")) {
+}
+
+void* HostArena::allocate(size_t bytes) {
+    size_t capacity = poolSizeClass(bytes);
+    {
+        std::lock_guard<std::mutex> guard(arenaMutex);
+        for (auto it = cached.rbegin(); it != cached.rend(); ++it) {
+            if (it->first == capacity) {
+                void* block = it->second;
+                cached.erase(std::next(it).base());
+                stats.bytesCached -= capacity;
+                stats.bytesInUse += capacity;
+                ++stats.hits;
+                return block;
+            }
+        }
+    }
+
+    void* block = std::aligned_alloc(minimumClass, capacity);
+    if (block == nullptr) {
+        trim();
+        block = std::aligned_alloc(minimumClass, capacity);
+    }
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    PHY250_COUNT(HostAllocations, 1);
+    PHY250_COUNT(AllocatedBytes, capacity);
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    ++stats.misses;
+    countAllocation(stats, capacity);
+    return block;
+}
+
+void HostArena::release(void* block, size_t bytes) {
+    if (block == nullptr) {
+        return;
+    }
+    size_t capacity = poolSizeClass(bytes);
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    stats.bytesInUse -= capacity;
+    if (capacity > limit) {
+        stats.trimmedBytes += capacity;
+        std::free(block);
+        return;
+    }
+    cached.emplace_back(capacity, block);
+    stats.bytesCached += capacity;
+    trimLocked(limit);
+}
+
+PoolStats HostArena::getStats() const {
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    return stats;
+}
+
+size_t HostArena::getLimit() const {
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    return limit;
+}
+
+void HostArena::setLimit(size_t bytes) {
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    limit = bytes;
+    trimLocked(limit);
+}
+
+void HostArena::trim(size_t keepBytes) {
+    std::lock_guard<std::mutex> guard(arenaMutex);
+    trimLocked(keepBytes);
+}
+
+void HostArena::trimLocked(size_t keepBytes) {
+    while (stats.bytesCached > keepBytes && !cached.empty()) {
+        std::pair<size_t, void*> block = cached.front();
+        cached.pop_front();
+        stats.bytesCached -= block.first;
+        stats.trimmedBytes += block.first;
+        std::free(block.second);
+    }
+}
@@ -0,0 +1,131 @@
+// buffer_pool.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef BUFFER_POOL_HPP
+#define BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include "opencl_runtime.hpp"
+
+// Counters for a pool. Hits are requests served from the cache, misses
+// needed a new allocation. In-use and cached bytes count whole size
+// classes, so they can exceed what was asked for by up to a quarter.
+struct PoolStats {
+    size_t hits;
+    size_t misses;
+    size_t bytesInUse;
+    size_t bytesCached;
+    size_t peakBytes;   // Highest bytesInUse + bytesCached so far
+    size_t trimmedBytes;  // Cached bytes freed by trim() or the limit
+};
+
+// Requests are rounded up to size classes of a power of two and its
+// 1.25x, 1.5x and 1.75x steps, with 4 KB the smallest, so a freed block can
+// serve any later request in its class.
+size_t poolSizeClass(size_t bytes);
+
+// A pinned host buffer that stays mapped while it is in the pool. host can
+// be filled or read directly and used as the host pointer of reads and
+// writes on buffer's context, which then run at full DMA speed.
+struct StagingBuffer {
+    cl_mem buffer;
+    void* host;
+    size_t capacity;
+};
+
+// Device and pinned host buffers for one OpenCLRuntime, reused across calls
+// instead of being created and released every time. Freed buffers are
+// cached by size class; once the cache holds more than the limit, the
+// least recently freed buffers are released. Set PHY250_CL_POOL_MB to
+// change the limit (default 256).
+//
+// A buffer must only be handed back once no queued command uses it, since
+// the next acquire may give it to a command on another queue.
+class BufferPool {
+public:
+    explicit BufferPool(OpenCLRuntime& runtime);
+    ~BufferPool();
+
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    // A CL_MEM_READ_WRITE buffer of at least bytes, or nullptr on failure
+    cl_mem acquire(size_t bytes);
+    void release(cl_mem buffer);
+
+    // A mapped CL_MEM_ALLOC_HOST_PTR buffer of at least bytes. buffer is
+    // nullptr on failure.
+    StagingBuffer acquireStaging(size_t bytes);
+    void releaseStaging(const StagingBuffer& staging);
+
+    PoolStats getStats() const;
+
+    size_t getLimit() const;
+    void setLimit(size_t bytes);
+
+    // Releases cached buffers, oldest first, until at most keepBytes remain
+    void trim(size_t keepBytes = 0);
+
+private:
+    struct Block {
+        cl_mem buffer;
+        void* host;  // Mapped pointer for staging buffers, else nullptr
+        size_t capacity;
+    };
+
+    cl_mem take(size_t capacity, bool staging, void** host);
+    void give(const Block& block);
+    void trimLocked(size_t keepBytes);
+    void destroy(const Block& block);
+
+    OpenCLRuntime& runtime;
+    mutable std::mutex poolMutex;
+    std::list<Block> cached;  // Least recently freed first
+    std::map<cl_mem, Block> inUse;
+    PoolStats stats;
+    size_t limit;
+};
+
+// Page-aligned host blocks for Matrix storage. Temporaries such as product
+// results and Strassen quadrants are freed and allocated again at the same
+// sizes over and over; the arena keeps freed blocks by size class and hands
+// them back out instead of going to the system allocator. Set
+// PHY250_HOST_POOL_MB to change how much it may cache (default 256).
+class HostArena {
+public:
+    // The shared arena. It is never destroyed, so storage freed during
+    // static destruction can still be returned to it.
+    static HostArena& instance();
+
+    // A block of poolSizeClass(bytes) bytes aligned to 4096, or nullptr
+    void* allocate(size_t bytes);
+
+    // Returns a block; bytes must be the size it was allocated with
+    void release(void* block, size_t bytes);
+
+    PoolStats getStats() const;
+
+    size_t getLimit() const;
+    void setLimit(size_t bytes);
+
+    // Frees cached blocks, oldest first, until at most keepBytes remain
+    void trim(size_t keepBytes = 0);
+
+private:
+    HostArena();
+
+    void trimLocked(size_t keepBytes);
+
+    mutable std::mutex arenaMutex;
+    std::list<std::pair<size_t, void*>> cached;  // Least recently freed first
+    PoolStats stats;
+    size_t limit;
+};
+
+#endif // BUFFER_POOL_HPP
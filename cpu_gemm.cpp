@@ -0,0 +1,422 @@
+// cpu_gemm.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CPU_GEMM_X86 1
+#endif
+
+#if defined(__GNUC__)
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+#define UNROLL _Pragma("GCC unroll 16")
+#else
+#define ALWAYS_INLINE inline
+#define UNROLL
+#endif
+
+namespace {
+
+// Cache blocking in the usual GotoBLAS order: a blockK x blockN panel of B
+// stays in L3, a blockM x blockK panel of A in L2, and one blockK x NR
+// sliver of B in L1 while the microkernel sweeps down the A panel.
+const int blockK = 256;
+const int blockM = 96;
+const int blockN = 4096;
+
+// Parallel runs split C into tiles of blockM rows by tileColumns columns,
+// each computed start to finish by one thread, so every element sees the
+// same summation order whatever the thread count. Below parallelWork
+// multiply-adds the scheduling costs more than it saves.
+const int tileColumns = 256;
+const double parallelWork = 96.0 * 96.0 * 96.0;
+
+// Per-thread packing buffers, grown on demand and reused across calls.
+template <typename T>
+T* packBuffer(int slot, size_t count) {
+    struct Buffer {
+        T* data = nullptr;
+        size_t size = 0;
+        ~Buffer() { std::free(data); }
+    };
+    thread_local Buffer buffers[2];
+
+    Buffer& buffer = buffers[slot];
+    if (buffer.size < count) {
+        std::free(buffer.data);
+        size_t bytes = (count * sizeof(T) + 63) / 64 * 64;
+        buffer.data = static_cast<T*>(std::aligned_alloc(64, bytes));
+        buffer.size = buffer.data ? count : 0;
+    }
+    return buffer.data;
+}
+
+// Start of the block at (row, col) of a matrix stored row-major, or stored
+// as its transpose
+template <typename T>
+const T* blockStart(const T* M, int stride, bool transposed, int row, int col) {
+    return transposed ? M + static_cast<size_t>(col) * stride + row : M + static_cast<size_t>(row) * stride + col;
+}
+
+// Packs an mc x kc block of A into slivers of MR rows stored column by
+// column, zero-padding the last sliver and widening to the accumulator type.
+// A transposed A is read down its columns, which are contiguous.
+template <typename T, typename Acc, int MR>
+void packA(int mc, int kc, const T* A, int strideA, bool transposed, Acc* packed) {
+    for (int i = 0; i < mc; i += MR) {
+        int rowsLeft = std::min(MR, mc - i);
+        for (int p = 0; p < kc; ++p) {
+            if (transposed) {
+                const T* source = A + static_cast<size_t>(p) * strideA + i;
+                for (int r = 0; r < MR; ++r) {
+                    *packed++ = r < rowsLeft ? static_cast<Acc>(source[r]) : Acc(0);
+                }
+                continue;
+            }
+            for (int r = 0; r < MR; ++r) {
+                *packed++ = r < rowsLeft ? static_cast<Acc>(A[static_cast<size_t>(i + r) * strideA + p]) : Acc(0);
+            }
+        }
+    }
+}
+
+// Packs a kc x nc block of B into slivers of NR columns stored row by row,
+// zero-padding the last sliver and widening to the accumulator type.
+template <typename T, typename Acc, int NR>
+void packB(int kc, int nc, const T* B, int strideB, bool transposed, Acc* packed) {
+    for (int j = 0; j < nc; j += NR) {
+        int colsLeft = std::min(NR, nc - j);
+        for (int p = 0; p < kc; ++p) {
+            int c = 0;
+            if (transposed) {
+                const T* source = B + static_cast<size_t>(j) * strideB + p;
+                for (; c < colsLeft; ++c) {
+                    *packed++ = static_cast<Acc>(source[static_cast<size_t>(c) * strideB]);
+                }
+            } else {
+                const T* source = B + static_cast<size_t>(p) * strideB + j;
+                for (; c < colsLeft; ++c) {
+                    *packed++ = static_cast<Acc>(source[c]);
+                }
+            }
+            for (; c < NR; ++c) {
+                *packed++ = Acc(0);
+            }
+        }
+    }
+}
+
+// MR x NR block of C (+)= packed A sliver * packed B sliver, with the
+// accumulators held in SIMD registers of W lanes.
+template <typename T, int MR, int NR, int W>
+ALWAYS_INLINE void microKernelVector(int kc, const T* a, const T* b, T* c, int strideC, bool accumulate) {
+    typedef T Vector __attribute__((vector_size(W * sizeof(T))));
+    const int NV = NR / W;
+
+    Vector acc[MR][NV];
+    UNROLL for (int i = 0; i < MR; ++i) {
+        UNROLL for (int v = 0; v < NV; ++v) {
+            acc[i][v] = Vector{};
+        }
+    }
+
+    for (int p = 0; p < kc; ++p) {
+        Vector bv[NV];
+        UNROLL for (int v = 0; v < NV; ++v) {
+            std::memcpy(&bv[v], b + p * NR + v * W, sizeof(Vector));
+        }
+        UNROLL for (int i = 0; i < MR; ++i) {
+            T ai = a[p * MR + i];
+            UNROLL for (int v = 0; v < NV; ++v) {
+                acc[i][v] += bv[v] * ai;
+            }
+        }
+    }
+
+    UNROLL for (int i = 0; i < MR; ++i) {
+        UNROLL for (int v = 0; v < NV; ++v) {
+            T* destination = c + static_cast<size_t>(i) * strideC + v * W;
+            if (accumulate) {
+                Vector old;
+                std::memcpy(&old, destination, sizeof(Vector));
+                acc[i][v] += old;
+            }
+            std::memcpy(destination, &acc[i][v], sizeof(Vector));
+        }
+    }
+}
+
+template <typename T, int MR, int NR>
+void microKernelScalar(int kc, const T* a, const T* b, T* c, int strideC, bool accumulate) {
+    T acc[MR][NR] = {};
+    for (int p = 0; p < kc; ++p) {
+        for (int i = 0; i < MR; ++i) {
+            T ai = a[p * MR + i];
+            for (int j = 0; j < NR; ++j) {
+                acc[i][j] += ai * b[p * NR + j];
+            }
+        }
+    }
+    for (int i = 0; i < MR; ++i) {
+        T* destination = c + static_cast<size_t>(i) * strideC;
+        for (int j = 0; j < NR; ++j) {
+            destination[j] = accumulate ? destination[j] + acc[i][j] : acc[i][j];
+        }
+    }
+}
+
+#ifdef CPU_GEMM_X86
+// Two vectors of accumulators per row in 6 rows: 12 of the 16 (AVX2) or 32
+// (AVX-512) vector registers, leaving room for the B sliver and broadcast.
+template <typename Acc>
+__attribute__((target("avx512f")))
+void microKernelAvx512(int kc, const Acc* a, const Acc* b, Acc* c, int strideC, bool accumulate) {
+    microKernelVector<Acc, 6, 128 / sizeof(Acc), 64 / sizeof(Acc)>(kc, a, b, c, strideC, accumulate);
+}
+
+template <typename Acc>
+__attribute__((target("avx2,fma")))
+void microKernelAvx2(int kc, const Acc* a, const Acc* b, Acc* c, int strideC, bool accumulate) {
+    microKernelVector<Acc, 6, 64 / sizeof(Acc), 32 / sizeof(Acc)>(kc, a, b, c, strideC, accumulate);
+}
+#endif
+
+// The epilogue runs on each tile of C right after its last panel, while the
+// tile is still in cache. With accumulateC the first panel adds to C too,
+// so C keeps its old values under the sum.
+template <typename T, typename Acc, int MR, int NR, void (*MicroKernel)(int, const Acc*, const Acc*, Acc*, int, bool)>
+void gemmBlocked(int rows, int inner, int cols, const T* A, int strideA, bool transposeA,
+                 const T* B, int strideB, bool transposeB, Acc* C, int strideC, const GemmEpilogue<Acc>& epilogue,
+                 bool accumulateC) {
+    const bool fused = !epilogue.isIdentity();
+    if (inner == 0 && accumulateC) {
+        if (fused) {
+            epilogue.apply(C, strideC, rows, cols, 0, 0);
+        }
+        return;
+    }
+    if (inner == 0) {
+        for (int i = 0; i < rows; ++i) {
+            std::fill_n(C + static_cast<size_t>(i) * strideC, cols, Acc(0));
+        }
+        if (fused) {
+            epilogue.apply(C, strideC, rows, cols, 0, 0);
+        }
+        return;
+    }
+
+    const int mcMax = (blockM + MR - 1) / MR * MR;
+    const int ncMax = (blockN + NR - 1) / NR * NR;
+    Acc* packedA = packBuffer<Acc>(0, static_cast<size_t>(mcMax) * blockK);
+    Acc* packedB = packBuffer<Acc>(1, static_cast<size_t>(ncMax) * blockK);
+    if (packedA == nullptr || packedB == nullptr) {
+        std::cerr << "Error: Failed to allocate GEMM packing buffers." << std::endl;
+        return;
+    }
+
+    Acc edge[MR * NR];
+    for (int jc = 0; jc < cols; jc += ncMax) {
+        int nc = std::min(ncMax, cols - jc);
+        for (int pc = 0; pc < inner; pc += blockK) {
+            int kc = std::min(blockK, inner - pc);
+            bool accumulate = accumulateC || pc > 0;
+            bool finishing = fused && pc + kc == inner;
+            packB<T, Acc, NR>(kc, nc, blockStart(B, strideB, transposeB, pc, jc), strideB, transposeB, packedB);
+
+            for (int ic = 0; ic < rows; ic += mcMax) {
+                int mc = std::min(mcMax, rows - ic);
+                packA<T, Acc, MR>(mc, kc, blockStart(A, strideA, transposeA, ic, pc), strideA, transposeA, packedA);
+
+                for (int jr = 0; jr < nc; jr += NR) {
+                    int nr = std::min(NR, nc - jr);
+                    const Acc* b = packedB + static_cast<size_t>(jr) * kc;
+                    for (int ir = 0; ir < mc; ir += MR) {
+                        int mr = std::min(MR, mc - ir);
+                        const Acc* a = packedA + static_cast<size_t>(ir) * kc;
+                        Acc* c = C + static_cast<size_t>(ic + ir) * strideC + jc + jr;
+
+                        if (mr == MR && nr == NR) {
+                            MicroKernel(kc, a, b, c, strideC, accumulate);
+                            if (finishing) {
+                                epilogue.apply(c, strideC, MR, NR, ic + ir, jc + jr);
+                            }
+                            continue;
+                        }
+
+                        // Edge tile: compute the full block into scratch and
+                        // copy back only the part inside C.
+                        MicroKernel(kc, a, b, edge, NR, false);
+                        for (int i = 0; i < mr; ++i) {
+                            Acc* destination = c + static_cast<size_t>(i) * strideC;
+                            for (int j = 0; j < nr; ++j) {
+                                destination[j] = accumulate ? destination[j] + edge[i * NR + j] : edge[i * NR + j];
+                            }
+                        }
+                        if (finishing) {
+                            epilogue.apply(c, strideC, mr, nr, ic + ir, jc + jr);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+enum KernelChoice {
+    ScalarKernel,
+    Avx2Kernel,
+    Avx512Kernel
+};
+
+const char* kernelNames[] = {"scalar", "avx2", "avx512"};
+
+KernelChoice chooseKernel() {
+    const char* forced = std::getenv("PHY250_CPU_KERNEL");
+    std::string request = forced ? forced : "";
+    if (request == "scalar") {
+        return ScalarKernel;
+    }
+
+#ifdef CPU_GEMM_X86
+    __builtin_cpu_init();
+    bool hasAvx512 = __builtin_cpu_supports("avx512f");
+    bool hasAvx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if (hasAvx512 && (request.empty() || request == "avx512")) {
+        return Avx512Kernel;
+    }
+    if (hasAvx2 && (request.empty() || request == "avx2" || request == "avx512")) {
+        return Avx2Kernel;
+    }
+#endif
+
+    return ScalarKernel;
+}
+
+KernelChoice selectedKernel() {
+    static const KernelChoice choice = chooseKernel();
+    return choice;
+}
+
+template <typename T, typename Acc>
+struct GemmBackend {
+    void (*function)(int, int, int, const T*, int, bool, const T*, int, bool, Acc*, int, const GemmEpilogue<Acc>&, bool);
+    int mr;
+    int nr;
+};
+
+template <typename T, typename Acc>
+GemmBackend<T, Acc> backend() {
+#ifdef CPU_GEMM_X86
+    const int lanes512 = 64 / sizeof(Acc);
+    const int lanes256 = 32 / sizeof(Acc);
+    switch (selectedKernel()) {
+    case Avx512Kernel:
+        return {gemmBlocked<T, Acc, 6, 2 * lanes512, microKernelAvx512<Acc>>, 6, 2 * lanes512};
+    case Avx2Kernel:
+        return {gemmBlocked<T, Acc, 6, 2 * lanes256, microKernelAvx2<Acc>>, 6, 2 * lanes256};
+    default:
+        break;
+    }
+#endif
+    return {gemmBlocked<T, Acc, 4, 4, microKernelScalar<Acc, 4, 4>>, 4, 4};
+}
+
+// Runs the selected backend over the thread pool, one tile of C per task
+template <typename T, typename Acc>
+void gemmDispatch(int rows, int inner, int cols,
+                  const T* A, int strideA, bool transposeA,
+                  const T* B, int strideB, bool transposeB,
+                  Acc* C, int strideC, const GemmEpilogue<Acc>& epilogue, bool accumulateC) {
+    if (rows <= 0 || cols <= 0) {
+        return;
+    }
+
+    PHY250_TIME_SCOPE("gemmCPU");
+    const GemmBackend<T, Acc> selected = backend<T, Acc>();
+    ThreadPool& pool = ThreadPool::instance();
+    if (pool.getThreadCount() == 1 || static_cast<double>(rows) * inner * cols < parallelWork) {
+        selected.function(rows, inner, cols, A, strideA, transposeA, B, strideB, transposeB, C, strideC, epilogue,
+                          accumulateC);
+        return;
+    }
+
+    int tileRows = (blockM + selected.mr - 1) / selected.mr * selected.mr;
+    int tileCols = (tileColumns + selected.nr - 1) / selected.nr * selected.nr;
+    int rowTiles = (rows + tileRows - 1) / tileRows;
+    int colTiles = (cols + tileCols - 1) / tileCols;
+
+    pool.parallelFor(rowTiles * colTiles, [&](int tile) {
+        int i = tile / colTiles * tileRows;
+        int j = tile % colTiles * tileCols;
+        selected.function(std::min(tileRows, rows - i), inner, std::min(tileCols, cols - j),
+                          blockStart(A, strideA, transposeA, i, 0), strideA, transposeA,
+                          blockStart(B, strideB, transposeB, 0, j), strideB, transposeB,
+                          C + static_cast<size_t>(i) * strideC + j, strideC, epilogue.offset(i, j), accumulateC);
+    });
+}
+
+} // namespace
+
+template <typename T, typename Acc>
+void gemmCPU(int rows, int inner, int cols,
+             const T* A, int strideA,
+             const T* B, int strideB,
+             Acc* C, int strideC) {
+    gemmDispatch(rows, inner, cols, A, strideA, false, B, strideB, false, C, strideC, GemmEpilogue<Acc>(), false);
+}
+
+template <typename T, typename Acc>
+void gemmCPU(int rows, int inner, int cols,
+             const T* A, int strideA, bool transposeA,
+             const T* B, int strideB, bool transposeB,
+             Acc* C, int strideC, const GemmEpilogue<Acc>& epilogue) {
+    gemmDispatch(rows, inner, cols, A, strideA, transposeA, B, strideB, transposeB, C, strideC, epilogue, false);
+}
+
+template <typename T, typename Acc>
+void gemmCPUAccumulate(int rows, int inner, int cols,
+                       const T* A, int strideA,
+                       const T* B, int strideB,
+                       Acc* C, int strideC) {
+    gemmDispatch(rows, inner, cols, A, strideA, false, B, strideB, false, C, strideC, GemmEpilogue<Acc>(), true);
+}
+
+const char* gemmCPUKernelName() {
+    return kernelNames[selectedKernel()];
+}
+
+template void gemmCPU<float, float>(int, int, int, const float*, int, const float*, int, float*, int);
+template void gemmCPU<double, double>(int, int, int, const double*, int, const double*, int, double*, int);
+template void gemmCPU<int32_t, int32_t>(int, int, int, const int32_t*, int, const int32_t*, int, int32_t*, int);
+template void gemmCPU<int64_t, int64_t>(int, int, int, const int64_t*, int, const int64_t*, int, int64_t*, int);
+template void gemmCPU<int8_t, int32_t>(int, int, int, const int8_t*, int, const int8_t*, int, int32_t*, int);
+
+template void gemmCPU<float, float>(int, int, int, const float*, int, bool, const float*, int, bool, float*, int,
+                                   const GemmEpilogue<float>&);
+template void gemmCPU<double, double>(int, int, int, const double*, int, bool, const double*, int, bool, double*, int,
+                                      const GemmEpilogue<double>&);
+template void gemmCPU<int32_t, int32_t>(int, int, int, const int32_t*, int, bool, const int32_t*, int, bool, int32_t*,
+                                        int, const GemmEpilogue<int32_t>&);
+template void gemmCPU<int64_t, int64_t>(int, int, int, const int64_t*, int, bool, const int64_t*, int, bool, int64_t*,
+                                        int, const GemmEpilogue<int64_t>&);
+template void gemmCPU<int8_t, int32_t>(int, int, int, const int8_t*, int, bool, const int8_t*, int, bool, int32_t*,
+                                       int, const GemmEpilogue<int32_t>&);
+
+template void gemmCPUAccumulate<float, float>(int, int, int, const float*, int, const float*, int, float*, int);
+template void gemmCPUAccumulate<double, double>(int, int, int, const double*, int, const double*, int, double*, int);
+template void gemmCPUAccumulate<int32_t, int32_t>(int, int, int, const int32_t*, int, const int32_t*, int, int32_t*,
+                                                  int);
+template void gemmCPUAccumulate<int64_t, int64_t>(int, int, int, const int64_t*, int, const int64_t*, int, int64_t*,
+                                                  int);
+template void gemmCPUAccumulate<int8_t, int32_t>(int, int, int, const int8_t*, int, const int8_t*, int, int32_t*, int);
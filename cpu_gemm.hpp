@@ -0,0 +1,49 @@
+// cpu_gemm.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef CPU_GEMM_HPP
+#define CPU_GEMM_HPP
+
+#include "gemm_epilogue.hpp"
+
+// C = A * B on the host, where A is rows x inner, B is inner x cols and C is
+// rows x cols, all row-major with the given row strides in elements.
+//
+// Operands are packed into cache-sized panels and multiplied by a register
+// blocked microkernel. The microkernel is picked once at runtime from the
+// CPU features: AVX-512, AVX2 or a portable scalar version. Set
+// PHY250_CPU_KERNEL to avx512, avx2 or scalar to force one.
+//
+// Instantiated for float, double, int32_t and int64_t, and for int8_t
+// inputs accumulating into int32_t; packing widens int8 to int32 so the
+// int32 microkernel does the arithmetic.
+template <typename T, typename Acc>
+void gemmCPU(int rows, int inner, int cols,
+             const T* A, int strideA,
+             const T* B, int strideB,
+             Acc* C, int strideC);
+
+// Fused form: C = epilogue(op(A) * op(B)), where op(M) is M, or the
+// transpose of M if its flag is set. A transposed A is stored inner x rows
+// and a transposed B cols x inner, each with its own row stride; the packing
+// step reads them in place, so nothing is copied first.
+template <typename T, typename Acc>
+void gemmCPU(int rows, int inner, int cols,
+             const T* A, int strideA, bool transposeA,
+             const T* B, int strideB, bool transposeB,
+             Acc* C, int strideC, const GemmEpilogue<Acc>& epilogue);
+
+// C += A * B, adding to what C holds instead of overwriting it, so a
+// product can be summed over blocks of inner without a scratch copy of C
+template <typename T, typename Acc>
+void gemmCPUAccumulate(int rows, int inner, int cols,
+                       const T* A, int strideA,
+                       const T* B, int strideB,
+                       Acc* C, int strideC);
+
+// Name of the microkernel gemmCPU dispatches to
+const char* gemmCPUKernelName();
+
+#endif // CPU_GEMM_HPP
@@ -0,0 +1,87 @@
+// gemm_epilogue.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef GEMM_EPILOGUE_HPP
+#define GEMM_EPILOGUE_HPP
+
+#include <cstddef>
+
+// Elementwise function applied to each result of a fused multiply
+template <typename Acc>
+struct PostOp {
+    enum Kind { Relu, Clamp, Abs, Add, Multiply };
+
+    Kind kind;
+    Acc first;   // Clamp lower bound, Add or Multiply operand
+    Acc second;  // Clamp upper bound
+
+    Acc apply(Acc x) const {
+        switch (kind) {
+        case Relu: return x > Acc(0) ? x : Acc(0);
+        case Clamp: return x < first ? first : x > second ? second : x;
+        case Abs: return x < Acc(0) ? -x : x;
+        case Add: return x + first;
+        case Multiply: return x * first;
+        }
+        return x;
+    }
+};
+
+// What a fused multiply stores for each sum s of A * B:
+//
+//     C = ops(alpha * s + beta * D)
+//
+// D is optional and may be transposed: element (i, j) is at
+// addend[i * addendRowStride + j * addendColStride]. It must not overlap C.
+// The ops run in order. The struct only points at D and the ops, so it is
+// cheap to copy.
+template <typename Acc>
+struct GemmEpilogue {
+    Acc alpha;
+    Acc beta;
+    const Acc* addend;
+    int addendRowStride;
+    int addendColStride;
+    const PostOp<Acc>* ops;
+    int opCount;
+
+    GemmEpilogue()
+        : alpha(1), beta(0), addend(nullptr), addendRowStride(0), addendColStride(1), ops(nullptr), opCount(0) {
+    }
+
+    bool isIdentity() const {
+        return alpha == Acc(1) && addend == nullptr && opCount == 0;
+    }
+
+    // The same epilogue for the block of C starting at (row, col)
+    GemmEpilogue offset(int row, int col) const {
+        GemmEpilogue shifted = *this;
+        if (addend != nullptr) {
+            shifted.addend = addend + static_cast<size_t>(row) * addendRowStride + static_cast<size_t>(col) * addendColStride;
+        }
+        return shifted;
+    }
+
+    // Applies the epilogue in place to the rows x cols block at C, which is
+    // element (row, col) of the result
+    void apply(Acc* C, int strideC, int rows, int cols, int row, int col) const {
+        for (int i = 0; i < rows; ++i) {
+            Acc* destination = C + static_cast<size_t>(i) * strideC;
+            for (int j = 0; j < cols; ++j) {
+                Acc value = alpha * destination[j];
+                if (addend != nullptr) {
+                    value += beta * addend[static_cast<size_t>(row + i) * addendRowStride +
+                                           static_cast<size_t>(col + j) * addendColStride];
+                }
+                for (int op = 0; op < opCount; ++op) {
+                    value = ops[op].apply(value);
+                }
+                destination[j] = value;
+            }
+        }
+    }
+};
+
+#endif // GEMM_EPILOGUE_HPP
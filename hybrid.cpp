@@ -0,0 +1,261 @@
+// hybrid.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "hybrid.hpp"
+#include "buffer_pool.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_async.hpp"
+#include "opencl_gemm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Smallest chunk either side takes, so every chunk is still a reasonable
+// multiply on its own
+const int minimumChunkRows = 32;
+
+// Hands out chunks of rows to the two sides and tracks how fast each one
+// gets through them
+class RowScheduler {
+public:
+    enum Side { CPU, Device };
+
+    explicit RowScheduler(int rows) : rows(rows), nextRow(0) {
+        for (int side = 0; side < 2; ++side) {
+            completed[side] = 0;
+            active[side] = true;
+            started[side] = false;
+        }
+    }
+
+    // Claims the next chunk for side. Returns false once every row is
+    // claimed.
+    bool claim(Side side, int& begin, int& end) {
+        std::lock_guard<std::mutex> guard(mutex);
+        if (!returned.empty()) {
+            begin = returned.back().first;
+            end = returned.back().second;
+            returned.pop_back();
+            return true;
+        }
+        int remaining = rows - nextRow;
+        if (remaining == 0) {
+            return false;
+        }
+        if (!started[side]) {
+            started[side] = true;
+            startTime[side] = std::chrono::steady_clock::now();
+        }
+
+        // Until both sides have a rate, chunks are small probes. After that
+        // each side takes its share of half the remaining rows, so chunks
+        // shrink as the end nears and both sides run out together.
+        const Side other = side == CPU ? Device : CPU;
+        int chunk;
+        if (!active[other]) {
+            chunk = remaining;
+        } else if (completed[side] == 0 || completed[other] == 0) {
+            chunk = std::max(minimumChunkRows, rows / 16);
+        } else {
+            double share = rate(side) / (rate(side) + rate(other));
+            chunk = std::max(minimumChunkRows, static_cast<int>(remaining * share / 2));
+        }
+        chunk = std::min(chunk, remaining);
+
+        begin = nextRow;
+        end = nextRow + chunk;
+        nextRow = end;
+        return true;
+    }
+
+    void finished(Side side, int count) {
+        std::lock_guard<std::mutex> guard(mutex);
+        completed[side] += count;
+    }
+
+    // Gives a claimed chunk back for the other side to compute
+    void giveBack(int begin, int end) {
+        std::lock_guard<std::mutex> guard(mutex);
+        returned.emplace_back(begin, end);
+    }
+
+    // The side takes no more chunks
+    void retire(Side side) {
+        std::lock_guard<std::mutex> guard(mutex);
+        active[side] = false;
+    }
+
+private:
+    // Rows per second since the side claimed its first chunk
+    double rate(Side side) const {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime[side];
+        return completed[side] / std::max(elapsed.count(), 1e-9);
+    }
+
+    std::mutex mutex;
+    int rows;
+    int nextRow;
+    int completed[2];
+    bool active[2];
+    bool started[2];
+    std::chrono::steady_clock::time_point startTime[2];
+    std::vector<std::pair<int, int>> returned;
+};
+
+// A chunk of rows in flight on the device, with its own A and C buffers
+struct DeviceSlot {
+    cl_mem bufferA = nullptr;
+    cl_mem bufferC = nullptr;
+    int capacity = 0;
+    cl_event done = nullptr;
+    int begin = 0;
+    int end = 0;
+};
+
+void releaseSlot(BufferPool& pool, DeviceSlot& slot) {
+    pool.release(slot.bufferA);
+    pool.release(slot.bufferC);
+    slot.bufferA = slot.bufferC = nullptr;
+    slot.capacity = 0;
+}
+
+// Device side of gemmHybrid, run on its own thread. Keeps two chunks in
+// flight so one chunk's transfers overlap the other's kernel.
+template <typename T, typename Acc>
+void runDevice(RowScheduler& scheduler, int inner, int cols,
+               const T* A, int strideA, const T* B, int strideB, Acc* C, int strideC, int rows) {
+    PHY250_TIME_SCOPE("hybridDevice");
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    cl_command_queue queue = runtime.getQueue();
+    BufferPool& pool = runtime.getBufferPool();
+    GemmConfig config = GemmAutotuner::instance().getConfig<T, Acc>(rows, inner, cols);
+
+    cl_int error;
+    cl_mem bufferB = pool.acquire(sizeof(T) * static_cast<size_t>(inner) * strideB);
+    if (bufferB == nullptr || enqueueWriteBlock(queue, bufferB, inner, cols, sizeof(T), strideB, B) != CL_SUCCESS) {
+        std::cerr << "ERROR Creating buffers" << std::endl;
+        clFinish(queue);
+        pool.release(bufferB);
+        scheduler.retire(RowScheduler::Device);
+        return;
+    }
+
+    DeviceSlot slots[2];
+    int next = 0;
+    auto complete = [&](DeviceSlot& slot) {
+        if (slot.done) {
+            clWaitForEvents(1, &slot.done);
+            clReleaseEvent(slot.done);
+            slot.done = nullptr;
+            scheduler.finished(RowScheduler::Device, slot.end - slot.begin);
+        }
+    };
+
+    int begin, end;
+    while (scheduler.claim(RowScheduler::Device, begin, end)) {
+        DeviceSlot& slot = slots[next];
+        next = 1 - next;
+        complete(slot);
+
+        const int height = end - begin;
+        if (slot.capacity < height) {
+            releaseSlot(pool, slot);
+            slot.bufferA = pool.acquire(sizeof(T) * static_cast<size_t>(height) * strideA);
+            slot.bufferC = pool.acquire(sizeof(Acc) * static_cast<size_t>(height) * strideC);
+            slot.capacity = slot.bufferA && slot.bufferC ? height : 0;
+        }
+
+        error = slot.capacity > 0 ? CL_SUCCESS : CL_MEM_OBJECT_ALLOCATION_FAILURE;
+        if (error == CL_SUCCESS) {
+            error = enqueueWriteBlock(queue, slot.bufferA, height, inner, sizeof(T), strideA,
+                                      A + static_cast<size_t>(begin) * strideA);
+        }
+        if (error == CL_SUCCESS) {
+            error = enqueueGemm<T, Acc>(config, slot.bufferA, bufferB, slot.bufferC, height, inner, cols,
+                                        strideA, strideB, strideC, queue);
+            if (error != CL_SUCCESS && config.isTiled()) {
+                error = enqueueGemm<T, Acc>(GemmConfig(), slot.bufferA, bufferB, slot.bufferC, height, inner, cols,
+                                            strideA, strideB, strideC, queue);
+            }
+        }
+        if (error == CL_SUCCESS) {
+            // The chunk lands directly in its rows of C
+            size_t origin[3] = {0, 0, 0};
+            size_t region[3] = {sizeof(Acc) * cols, static_cast<size_t>(height), 1};
+            size_t pitch = sizeof(Acc) * strideC;
+            PHY250_COUNT(BytesRead, region[0] * height);
+            error = clEnqueueReadBufferRect(queue, slot.bufferC, CL_FALSE, origin, origin, region, pitch, 0, pitch, 0,
+                                            C + static_cast<size_t>(begin) * strideC, 0, nullptr, &slot.done);
+            runtime.recordEvent(OpenCLRuntime::ProfileRead, slot.done);
+        }
+        if (error != CL_SUCCESS) {
+            std::cerr << "ERROR Enqueueing hybrid multiply; finishing on the CPU" << std::endl;
+            slot.done = nullptr;
+            clFinish(queue);
+            scheduler.retire(RowScheduler::Device);
+            scheduler.giveBack(begin, end);
+            break;
+        }
+        slot.begin = begin;
+        slot.end = end;
+        clFlush(queue);
+    }
+
+    for (DeviceSlot& slot : slots) {
+        complete(slot);
+        releaseSlot(pool, slot);
+    }
+    pool.release(bufferB);
+    scheduler.retire(RowScheduler::Device);
+}
+
+} // namespace
+
+template <typename T, typename Acc>
+void gemmHybrid(int rows, int inner, int cols,
+                const T* A, int strideA,
+                const T* B, int strideB,
+                Acc* C, int strideC) {
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    if (rows < 2 * minimumChunkRows || inner == 0 || cols == 0 || !runtime.isAvailable() ||
+        !OpenCLElement<T>::isSupported() || !OpenCLElement<Acc>::isSupported()) {
+        gemmCPU(rows, inner, cols, A, strideA, B, strideB, C, strideC);
+        return;
+    }
+
+    RowScheduler scheduler(rows);
+    std::thread device([&]() {
+        runDevice<T, Acc>(scheduler, inner, cols, A, strideA, B, strideB, C, strideC, rows);
+    });
+
+    // The CPU side runs here. Chunks the device gave back after the CPU ran
+    // out of rows are picked up once the device thread is done.
+    int begin, end;
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            device.join();
+        }
+        while (scheduler.claim(RowScheduler::CPU, begin, end)) {
+            gemmCPU(end - begin, inner, cols, A + static_cast<size_t>(begin) * strideA, strideA, B, strideB,
+                    C + static_cast<size_t>(begin) * strideC, strideC);
+            scheduler.finished(RowScheduler::CPU, end - begin);
+        }
+    }
+}
+
+template void gemmHybrid<float, float>(int, int, int, const float*, int, const float*, int, float*, int);
+template void gemmHybrid<double, double>(int, int, int, const double*, int, const double*, int, double*, int);
+template void gemmHybrid<int32_t, int32_t>(int, int, int, const int32_t*, int, const int32_t*, int, int32_t*, int);
+template void gemmHybrid<int64_t, int64_t>(int, int, int, const int64_t*, int, const int64_t*, int, int64_t*, int);
+template void gemmHybrid<int8_t, int32_t>(int, int, int, const int8_t*, int, const int8_t*, int, int32_t*, int);
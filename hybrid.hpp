@@ -0,0 +1,25 @@
+// hybrid.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef HYBRID_HPP
+#define HYBRID_HPP
+
+// C = A * B on the CPU and the OpenCL device at the same time, with the
+// same layout as gemmCPU. Both sides take chunks of rows of C from a shared
+// counter until none are left: the CPU runs gemmCPU on its chunks, and a
+// feeder thread streams the device's chunks of A through two staging
+// buffers while B stays on the device. Both write their rows straight into
+// C.
+//
+// Chunk sizes follow the rows per second each side has achieved so far in
+// this call, and shrink towards the end so both sides finish together. If
+// the device is unavailable or fails, the CPU does the remaining rows.
+template <typename T, typename Acc>
+void gemmHybrid(int rows, int inner, int cols,
+                const T* A, int strideA,
+                const T* B, int strideB,
+                Acc* C, int strideC);
+
+#endif // HYBRID_HPP
@@ -0,0 +1,182 @@
+// instrumentation.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+// Past this many events a trace only keeps counting
+const size_t maximumTraceEvents = 1 << 20;
+
+// Small per-thread numbers for the trace's tid field
+int threadNumber() {
+    static std::atomic<int> nextThread(1);
+    thread_local int number = nextThread.fetch_add(1);
+    return number;
+}
+
+std::string jsonString(const char* text) {
+    std::string quoted = "\"";
+    for (const char* c = text; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            quoted += '\\';
+        }
+        quoted += *c;
+    }
+    return quoted + "\"";
+}
+
+void writeTraceAtExit() {
+    const char* path = std::getenv("PHY250_TRACE");
+    if (path != nullptr && !Instrumentation::instance().writeChromeTrace(path)) {
+        std::cerr << "Error: Cannot write trace to " << path << std::endl;
+    }
+}
+
+} // namespace
+
+Instrumentation& Instrumentation::instance() {
+    static Instrumentation* instrumentation = new Instrumentation();
+    return *instrumentation;
+}
+
+Instrumentation::Instrumentation() : tracing(false), epoch(std::chrono::steady_clock::now()), droppedEvents(0) {
+    for (std::atomic<uint64_t>& counter : counters) {
+        counter.store(0);
+    }
+
+    const char* path = std::getenv("PHY250_TRACE");
+    if (path != nullptr && *path != '\0') {
+        if (!isCompiledIn()) {
+            std::cerr << "Warning: PHY250_TRACE is set but the library was built without PHY250_INSTRUMENT"
+                      << std::endl;
+        }
+        tracing = true;
+        std::atexit(writeTraceAtExit);
+    }
+}
+
+bool Instrumentation::isCompiledIn() {
+#ifdef PHY250_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* Instrumentation::counterName(Counter counter) {
+    switch (counter) {
+    case BytesWritten: return "bytes_written";
+    case BytesRead: return "bytes_read";
+    case HostAllocations: return "host_allocations";
+    case DeviceAllocations: return "device_allocations";
+    case AllocatedBytes: return "allocated_bytes";
+    case KernelLaunches: return "kernel_launches";
+    case ProgramBuilds: return "program_builds";
+    case ProgramCacheLoads: return "program_cache_loads";
+    case CounterCount: break;
+    }
+    return "unknown";
+}
+
+void Instrumentation::recordScope(const char* name, std::chrono::steady_clock::time_point start,
+                                  std::chrono::steady_clock::time_point end) {
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::lock_guard<std::mutex> guard(instrumentationMutex);
+    Totals& total = totals[name];
+    ++total.calls;
+    total.totalSeconds += seconds;
+    total.maxSeconds = std::max(total.maxSeconds, seconds);
+
+    if (!tracing.load(std::memory_order_relaxed)) {
+        return;
+    }
+    if (events.size() >= maximumTraceEvents) {
+        ++droppedEvents;
+        return;
+    }
+    Event event;
+    event.name = name;
+    event.thread = threadNumber();
+    event.startMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(start - epoch).count();
+    event.durationMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    events.push_back(event);
+}
+
+void Instrumentation::setTracing(bool enabled) {
+    tracing = enabled;
+}
+
+bool Instrumentation::isTracing() const {
+    return tracing;
+}
+
+Instrumentation::Snapshot Instrumentation::snapshot() const {
+    Snapshot result;
+    for (int i = 0; i < CounterCount; ++i) {
+        result.counters[i] = counters[i].load(std::memory_order_relaxed);
+    }
+
+    std::lock_guard<std::mutex> guard(instrumentationMutex);
+    // The same name can be several literals, one per translation unit
+    std::map<std::string, Totals> merged;
+    for (const auto& entry : totals) {
+        Totals& total = merged[entry.first];
+        total.calls += entry.second.calls;
+        total.totalSeconds += entry.second.totalSeconds;
+        total.maxSeconds = std::max(total.maxSeconds, entry.second.maxSeconds);
+    }
+    for (const auto& entry : merged) {
+        TimerStats timer = {entry.first, entry.second.calls, entry.second.totalSeconds, entry.second.maxSeconds};
+        result.timers.push_back(timer);
+    }
+    std::sort(result.timers.begin(), result.timers.end(), [](const TimerStats& a, const TimerStats& b) {
+        return a.totalSeconds > b.totalSeconds;
+    });
+    result.traceEvents = events.size();
+    result.droppedEvents = droppedEvents;
+    return result;
+}
+
+void Instrumentation::reset() {
+    for (std::atomic<uint64_t>& counter : counters) {
+        counter.store(0);
+    }
+    std::lock_guard<std::mutex> guard(instrumentationMutex);
+    totals.clear();
+    events.clear();
+    droppedEvents = 0;
+}
+
+bool Instrumentation::writeChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(instrumentationMutex);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    int64_t last = 0;
+    for (const Event& event : events) {
+        file << "{\"name\": " << jsonString(event.name) << ", \"cat\": \"phy250\", \"ph\": \"X\", \"pid\": 1, "
+             << "\"tid\": " << event.thread << ", \"ts\": " << event.startMicroseconds
+             << ", \"dur\": " << event.durationMicroseconds << "},\n";
+        last = std::max(last, event.startMicroseconds + event.durationMicroseconds);
+    }
+
+    // Counters go last, as one sample at the end of the timeline
+    file << "{\"name\": \"counters\", \"ph\": \"C\", \"pid\": 1, \"tid\": 0, \"ts\": " << last << ", \"args\": {";
+    for (int i = 0; i < CounterCount; ++i) {
+        file << (i > 0 ? ", " : "") << jsonString(counterName(static_cast<Counter>(i))) << ": "
+             << counters[i].load(std::memory_order_relaxed);
+    }
+    file << "}}\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,146 @@
+// instrumentation.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Timers and counters for the library's hot paths: OpenCL setup, program
+// builds, allocations, transfers, kernel launches and the multiplies
+// themselves.
+//
+// The library records them only when built with -DPHY250_INSTRUMENT.
+// Without it the PHY250_TIME_SCOPE and PHY250_COUNT macros expand to
+// nothing, not even their arguments are evaluated, and snapshots are
+// empty.
+//
+// With it, every timed scope is added to per-name totals. Tracing also
+// keeps each scope as an event on its thread's timeline; writeChromeTrace
+// saves those as a Chrome trace-event file for chrome://tracing or
+// Perfetto. Set PHY250_TRACE to a file name to trace from the start and
+// write the file when the program exits.
+class Instrumentation {
+public:
+    enum Counter {
+        BytesWritten,       // Host to device
+        BytesRead,          // Device to host
+        HostAllocations,    // New matrix storage blocks
+        DeviceAllocations,  // clCreateBuffer calls
+        AllocatedBytes,     // Bytes of both kinds of allocation
+        KernelLaunches,
+        ProgramBuilds,      // Programs compiled from source
+        ProgramCacheLoads,  // Programs loaded from the binary cache
+        CounterCount
+    };
+
+    // Totals for one scope name
+    struct TimerStats {
+        std::string name;
+        uint64_t calls;
+        double totalSeconds;
+        double maxSeconds;
+    };
+
+    struct Snapshot {
+        uint64_t counters[CounterCount];
+        std::vector<TimerStats> timers;  // Most total time first
+        size_t traceEvents;
+        size_t droppedEvents;  // Events past the trace limit
+    };
+
+    // The shared instance. It is never destroyed, so scopes ending during
+    // static destruction are still recorded.
+    static Instrumentation& instance();
+
+    // True if the library was built with PHY250_INSTRUMENT
+    static bool isCompiledIn();
+
+    static const char* counterName(Counter counter);
+
+    void add(Counter counter, uint64_t amount) {
+        counters[counter].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // Adds one run of the named scope. name must outlive the process,
+    // e.g. a string literal.
+    void recordScope(const char* name, std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end);
+
+    // Tracing keeps every scope until the limit of about a million events
+    void setTracing(bool enabled);
+    bool isTracing() const;
+
+    Snapshot snapshot() const;
+
+    // Zeroes the counters and timers and drops the trace
+    void reset();
+
+    // Writes the trace and the final counter values as Chrome trace-event
+    // JSON. Returns false if the file cannot be written.
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    struct Event {
+        const char* name;
+        int thread;
+        int64_t startMicroseconds;
+        int64_t durationMicroseconds;
+    };
+
+    struct Totals {
+        uint64_t calls;
+        double totalSeconds;
+        double maxSeconds;
+    };
+
+    Instrumentation();
+
+    std::atomic<uint64_t> counters[CounterCount];
+    std::atomic<bool> tracing;
+    std::chrono::steady_clock::time_point epoch;
+
+    mutable std::mutex instrumentationMutex;
+    std::map<const char*, Totals> totals;  // By name pointer; merged by text in snapshot()
+    std::vector<Event> events;
+    size_t droppedEvents;
+};
+
+// Times the enclosing scope
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const char* name) : name(name), start(std::chrono::steady_clock::now()) {
+    }
+
+    ~ScopedTimer() {
+        Instrumentation::instance().recordScope(name, start, std::chrono::steady_clock::now());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name;
+    std::chrono::steady_clock::time_point start;
+};
+
+#define PHY250_CONCAT_INNER(a, b) a##b
+#define PHY250_CONCAT(a, b) PHY250_CONCAT_INNER(a, b)
+
+#ifdef PHY250_INSTRUMENT
+#define PHY250_TIME_SCOPE(name) ScopedTimer PHY250_CONCAT(scopedTimer, __LINE__)(name)
+#define PHY250_COUNT(counter, amount) Instrumentation::instance().add(Instrumentation::counter, (amount))
+#else
+#define PHY250_TIME_SCOPE(name) ((void)0)
+#define PHY250_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_HPP
@@ -4,229 +4,796 @@
 //
 
 #include "matrix.hpp"
+#include "buffer_pool.hpp"
+#include "cpu_gemm.hpp"
+#include "hybrid.hpp"
+#include "instrumentation.hpp"
+#include "matrix_file.hpp"
+#include "multi_device.hpp"
+#include "opencl_async.hpp"
+#include "opencl_gemm.hpp"
+#include "sparse_matrix.hpp"
+#include "strassen.hpp"
+#include "verify.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+// Storage is page aligned (HostArena blocks are) so CL_MEM_USE_HOST_PTR can
+// wrap it without a copy on zero-copy devices, and rows are padded to a
+// whole cache line.
+const int strideAlignmentBytes = 64;
+
+namespace {
+
+// Destructor callback for device buffers that wrap a matrix's storage. The
+// buffer holds its own reference to the storage, so a matrix destroyed
+// while commands on its buffer are still queued cannot free memory the
+// device is using.
+template <typename T>
+void CL_CALLBACK releaseHostStorage(cl_mem, void* storage) {
+    delete static_cast<std::shared_ptr<T>*>(storage);
+}
 
-const char* kernelSource = R"(
-    __kernel void matrixMul(__global const int* A,
-                             __global const int* B,
-                             __global int* C,
-                             const int rowsA,
-                             const int colsA,
-                             const int colsB) {
-        int globalRow = get_global_id(0);
-        int globalCol = get_global_id(1);
-        int sum = 0;
-
-        for (int k = 0; k < colsA; ++k) {
-            sum += A[globalRow * colsA + k] * B[k * colsB + globalCol];
-        }
-
-        C[globalRow * colsB + globalCol] = sum;
-    }
-)";
+} // namespace
 
-Matrix::Matrix() : rows(0), cols(0), platform(nullptr), device(nullptr), context(nullptr), program(nullptr), kernel(nullptr),
-                   bufferA(nullptr), bufferB(nullptr), bufferResult(nullptr) {
-    initializeOpenCL();
+template <typename T>
+Matrix<T>::Matrix() : rows(0), cols(0), stride(0), deviceBuffer(nullptr), hostValid(true), deviceValid(false), deviceBusy(false) {
 }
 
-Matrix::Matrix(int rows, int cols) : Matrix() {
+template <typename T>
+Matrix<T>::Matrix(int rows, int cols) : Matrix() {
     this->rows = rows;
     this->cols = cols;
-    data = std::vector<std::vector<int>>(rows, std::vector<int>(cols, 0));
+    allocate();
+}
+
+template <typename T>
+Matrix<T>::Matrix(int rows, int cols, const std::vector<std::vector<T>>& data) : Matrix(rows, cols) {
+    for (int i = 0; i < rows && i < static_cast<int>(data.size()); ++i) {
+        std::copy_n(data[i].begin(), std::min(cols, static_cast<int>(data[i].size())), row(i));
+    }
+}
+
+template <typename T>
+int Matrix<T>::strideFor(int cols) {
+    const int strideAlignment = strideAlignmentBytes / sizeof(T);
+    return (cols + strideAlignment - 1) / strideAlignment * strideAlignment;
+}
+
+template <typename T>
+void Matrix<T>::allocate() {
+    releaseDevice();
+    hostValid = true;
+
+    stride = strideFor(cols);
+    size_t bytes = sizeof(T) * static_cast<size_t>(rows) * stride;
+    if (bytes == 0) {
+        storage.reset();
+        return;
+    }
+
+    // Storage comes from the host arena, so temporaries reuse the blocks of
+    // matrices freed before them
+    T* buffer = static_cast<T*>(HostArena::instance().allocate(bytes));
+    if (buffer == nullptr) {
+        std::cerr << "Error: Failed to allocate matrix storage." << std::endl;
+        rows = cols = stride = 0;
+        storage.reset();
+        return;
+    }
+    std::memset(buffer, 0, bytes);
+    storage = std::shared_ptr<T>(buffer, [bytes](T* block) { HostArena::instance().release(block, bytes); });
+}
+
+template <typename T>
+Matrix<T>::~Matrix() {
+    releaseDevice();
 }
 
-Matrix::Matrix(int rows, int cols, const std::vector<std::vector<int>>& data) : Matrix(rows, cols) {
-    this->data = data;
+template <typename T>
+Matrix<T>::Matrix(const Matrix& other) : Matrix(other.rows, other.cols) {
+    copyFrom(other);
 }
 
-Matrix::~Matrix() {
-    clReleaseKernel(kernel);
-    clReleaseProgram(program);
-    clReleaseContext(context);
+template <typename T>
+Matrix<T>::Matrix(Matrix&& other) : Matrix() {
+    *this = std::move(other);
 }
 
-Matrix::Matrix(const Matrix& other) : Matrix() {
-    rows = other.rows;
-    cols = other.cols;
-    data = other.data;
+template <typename T>
+Matrix<T>& Matrix<T>::operator=(const Matrix& other) {
+    if (this != &other) {
+        if (rows != other.rows || cols != other.cols) {
+            rows = other.rows;
+            cols = other.cols;
+            allocate();
+        }
+        copyFrom(other);
+    }
+    return *this;
 }
 
-Matrix& Matrix::operator=(const Matrix& other) {
+template <typename T>
+Matrix<T>& Matrix<T>::operator=(Matrix&& other) {
     if (this != &other) {
+        releaseDevice();
         rows = other.rows;
         cols = other.cols;
-        data = other.data;
+        stride = other.stride;
+        storage = std::move(other.storage);
+        deviceBuffer = other.deviceBuffer;
+        hostValid = other.hostValid;
+        deviceValid = other.deviceValid;
+        deviceBusy = other.deviceBusy;
+
+        other.rows = other.cols = other.stride = 0;
+        other.deviceBuffer = nullptr;
+        other.hostValid = true;
+        other.deviceValid = false;
+        other.deviceBusy = false;
     }
     return *this;
 }
 
-int Matrix::getRows() const {
+template <typename T>
+void Matrix<T>::copyFrom(const Matrix& other) {
+    if (!storage) {
+        return;
+    }
+    PHY250_TIME_SCOPE("copyMatrix");
+    size_t bytes = sizeof(T) * static_cast<size_t>(rows) * stride;
+
+    // A matrix that only lives on the device is copied there, so copies of
+    // intermediate results stay resident.
+    if (!other.hostValid) {
+        cl_mem buffer = getDeviceBuffer();
+        if (buffer != nullptr) {
+            cl_int error = clEnqueueCopyBuffer(OpenCLRuntime::instance().getQueue(), other.deviceBuffer, buffer,
+                                               0, 0, bytes, 0, nullptr, nullptr);
+            if (error == CL_SUCCESS) {
+                hostValid = false;
+                deviceValid = true;
+                deviceBusy = true;
+                other.deviceBusy = true;
+                return;
+            }
+        }
+    }
+
+    waitForDevice();
+    std::memcpy(storage.get(), other.data(), bytes);
+    hostValid = true;
+    deviceValid = false;
+}
+
+template <typename T>
+int Matrix<T>::getRows() const {
     return rows;
 }
 
-int Matrix::getCols() const {
+template <typename T>
+int Matrix<T>::getCols() const {
     return cols;
 }
 
-int Matrix::getElement(int row, int col) const {
-    return data[row][col];
+template <typename T>
+int Matrix<T>::getStride() const {
+    return stride;
 }
 
-void Matrix::setElement(int row, int col, int value) {
-    data[row][col] = value;
+template <typename T>
+T Matrix<T>::getElement(int row, int col) const {
+    syncHost();
+    return storage.get()[static_cast<size_t>(row) * stride + col];
 }
 
-Matrix Matrix::transpose() const {
-    Matrix result(cols, rows);
+template <typename T>
+void Matrix<T>::setElement(int row, int col, T value) {
+    prepareHostWrite();
+    storage.get()[static_cast<size_t>(row) * stride + col] = value;
+}
 
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < cols; ++j) {
-            result.data[j][i] = data[i][j];
-        }
-    }
+template <typename T>
+T* Matrix<T>::data() {
+    prepareHostWrite();
+    return storage.get();
+}
 
-    return result;
+template <typename T>
+const T* Matrix<T>::data() const {
+    syncHost();
+    return storage.get();
 }
 
-Matrix Matrix::multiplyCPU(Matrix& other){
-    if (cols != other.rows) {
-        return Matrix();
-    }
+template <typename T>
+T* Matrix<T>::row(int r) {
+    prepareHostWrite();
+    return storage.get() + static_cast<size_t>(r) * stride;
+}
 
-    Matrix result(rows, other.cols);
+template <typename T>
+const T* Matrix<T>::row(int r) const {
+    syncHost();
+    return storage.get() + static_cast<size_t>(r) * stride;
+}
 
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < other.cols; ++j) {
-            int sum = 0;
-            for (int k = 0; k < cols; ++k) {
-                sum += data[i][k] * other.data[k][j];
-            }
-            result.data[i][j] = sum;
-        }
-    }
+template <typename T>
+bool Matrix<T>::isOnHost() const {
+    return hostValid;
+}
 
-    return result;
+template <typename T>
+bool Matrix<T>::isOnDevice() const {
+    return deviceValid;
 }
 
-void Matrix::initializeOpenCL() {
-    cl_uint numPlatforms;
+template <typename T>
+cl_mem Matrix<T>::getDeviceBuffer() const {
+    if (deviceBuffer != nullptr || !storage) {
+        return deviceBuffer;
+    }
 
+    // The buffer wraps the host storage, so on zero-copy devices the two
+    // copies share memory and transfers cost nothing.
+    PHY250_TIME_SCOPE("createBuffer");
     cl_int error;
-    clGetPlatformIDs(0, nullptr, &numPlatforms);
+    size_t bytes = sizeof(T) * static_cast<size_t>(rows) * stride;
+    PHY250_COUNT(DeviceAllocations, 1);
+    PHY250_COUNT(AllocatedBytes, bytes);
+    deviceBuffer = clCreateBuffer(OpenCLRuntime::instance().getContext(), CL_MEM_READ_WRITE | CL_MEM_USE_HOST_PTR,
+                                  bytes, storage.get(), &error);
+    if (deviceBuffer == nullptr) {
+        std::cerr << "ERROR Creating buffers" << std::endl;
+        return nullptr;
+    }
+    clSetMemObjectDestructorCallback(deviceBuffer, releaseHostStorage<T>, new std::shared_ptr<T>(storage));
+    deviceValid = false;
+    return deviceBuffer;
+}
 
-    if (numPlatforms == 0) {
-        std::cerr << "Error: No OpenCL platforms available." << std::endl;
+template <typename T>
+void Matrix<T>::upload() const {
+    if (deviceValid) {
+        return;
+    }
+    cl_mem buffer = getDeviceBuffer();
+    if (buffer == nullptr) {
         return;
     }
 
-    std::vector<cl_platform_id> platforms(numPlatforms);
-    error = clGetPlatformIDs(numPlatforms, platforms.data(), nullptr);
+    // Writing from the storage the buffer was created over is allowed once
+    // earlier commands on the buffer are done, which the in-order queue
+    // guarantees. The host copy stays current.
+    PHY250_TIME_SCOPE("upload");
+    size_t bytes = sizeof(T) * static_cast<size_t>(rows) * stride;
+    PHY250_COUNT(BytesWritten, bytes);
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    cl_int error = clEnqueueWriteBuffer(runtime.getQueue(), buffer, CL_FALSE, 0, bytes, storage.get(), 0, nullptr,
+                                        runtime.profileEvent(OpenCLRuntime::ProfileWrite));
     if (error != CL_SUCCESS) {
-      std::cerr << "ERROR GETTING PLATFORM ID" << std::endl;
+        std::cerr << "ERROR Writing buffer" << std::endl;
+        return;
     }
+    deviceValid = true;
+    deviceBusy = true;
+}
 
-    platform = platforms[0];
+template <typename T>
+void Matrix<T>::download() const {
+    syncHost();
+}
 
-    cl_uint numDevices;
-    error = clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices);
-    if (error != CL_SUCCESS) {
-      std::cerr << "ERROR GETTING Device IDS" << std::endl;
+template <typename T>
+void Matrix<T>::waitForDevice() const {
+    if (deviceBusy) {
+        PHY250_TIME_SCOPE("waitForDevice");
+        OpenCLRuntime::instance().finish();
+        deviceBusy = false;
     }
+}
 
-    if (numDevices == 0) {
-        std::cerr << "Error: No GPU devices available." << std::endl;
+template <typename T>
+void Matrix<T>::syncHost() const {
+    if (hostValid) {
         return;
     }
 
-    std::vector<cl_device_id> devices(numDevices);
-    error = clGetDeviceIDs(platform, CL_DEVICE_TYPE_ALL, numDevices, devices.data(), nullptr);
+    // The queue is in order, so the blocking read starts after every
+    // command that writes this buffer has finished.
+    PHY250_TIME_SCOPE("readback");
+    size_t bytes = sizeof(T) * static_cast<size_t>(rows) * stride;
+    PHY250_COUNT(BytesRead, bytes);
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    cl_int error = clEnqueueReadBuffer(runtime.getQueue(), deviceBuffer, CL_TRUE, 0, bytes, storage.get(), 0, nullptr,
+                                       runtime.profileEvent(OpenCLRuntime::ProfileRead));
     if (error != CL_SUCCESS) {
-      std::cerr << "ERROR GETTING Device IDS" << std::endl;
+        std::cerr << "ERROR Reading result" << std::endl;
     }
+    hostValid = true;
+    deviceBusy = false;
+}
 
+template <typename T>
+void Matrix<T>::prepareHostWrite() {
+    syncHost();
+    waitForDevice();
+    deviceValid = false;
+}
 
-    device = devices[0];
+template <typename T>
+void Matrix<T>::releaseDevice() {
+    if (deviceBuffer != nullptr) {
+        clReleaseMemObject(deviceBuffer);
+        deviceBuffer = nullptr;
+    }
+    deviceValid = false;
+    deviceBusy = false;
+}
 
-    context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, nullptr);
+template <typename T>
+MatrixView<T> Matrix<T>::transpose() const {
+    return MatrixView<T>(*this, true);
+}
 
-    commandQueue = clCreateCommandQueue(context, device, 0, NULL);
+template <typename T>
+MatrixView<T>::MatrixView(const Matrix<T>& matrix, bool transposed) : matrix(&matrix), transposed(transposed) {
+}
 
+template <typename T>
+int MatrixView<T>::getRows() const {
+    return transposed ? matrix->getCols() : matrix->getRows();
+}
 
-    program = clCreateProgramWithSource(context, 1, &kernelSource, nullptr, nullptr);
-    error = clBuildProgram(program, 1, &device, nullptr, nullptr, nullptr);
-    if (error != CL_SUCCESS) {
-      std::cerr << "ERROR Building program" << std::endl;
-    }
+template <typename T>
+int MatrixView<T>::getCols() const {
+    return transposed ? matrix->getRows() : matrix->getCols();
+}
 
-    kernel = clCreateKernel(program, "matrixMul", nullptr);
+template <typename T>
+T MatrixView<T>::getElement(int row, int col) const {
+    return transposed ? matrix->getElement(col, row) : matrix->getElement(row, col);
+}
 
+template <typename T>
+bool MatrixView<T>::isTransposed() const {
+    return transposed;
+}
 
+template <typename T>
+const Matrix<T>& MatrixView<T>::getMatrix() const {
+    return *matrix;
 }
 
-Matrix Matrix::multiplyOpenCL(Matrix& other){
-    if (context == nullptr || device == nullptr || program == nullptr || kernel == nullptr) {
-        return Matrix();
+template <typename T>
+MatrixView<T> MatrixView<T>::transpose() const {
+    return MatrixView(*matrix, !transposed);
+}
+
+template <typename T>
+MatrixView<T>::operator Matrix<T>() const {
+    if (!transposed) {
+        return *matrix;
+    }
+
+    PHY250_TIME_SCOPE("transposeCopy");
+    Matrix<T> result(getRows(), getCols());
+    T* destination = result.data();
+    for (int i = 0; i < matrix->getRows(); ++i) {
+        const T* src = matrix->row(i);
+        for (int j = 0; j < matrix->getCols(); ++j) {
+            destination[static_cast<size_t>(j) * result.getStride() + i] = src[j];
+        }
     }
 
+    return result;
+}
+
+template <typename T>
+Matrix<typename Matrix<T>::ResultType> Matrix<T>::multiplyCPU(Matrix& other){
     if (cols != other.rows) {
-        return Matrix();
+        return Matrix<ResultType>();
     }
 
-    std::vector<int> tempBufferA;
-    for (const auto& row : data) {
-        tempBufferA.insert(tempBufferA.end(), row.begin(), row.end());
+    Matrix<ResultType> result(rows, other.cols);
+    if (!result.storage) {
+        return result;
     }
 
-    std::vector<int> tempBufferB;
-    for (const auto& row : other.data) {
-        tempBufferB.insert(tempBufferB.end(), row.begin(), row.end());
+    // Read through const references so the operands' device copies stay valid
+    PHY250_TIME_SCOPE("multiplyCPU");
+    const Matrix& a = *this;
+    const Matrix& b = other;
+    gemmCPU(rows, cols, other.cols, a.data(), stride, b.data(), other.stride, result.data(), result.stride);
+
+    return result;
+}
+
+template <typename T>
+Matrix<typename Matrix<T>::ResultType> Matrix<T>::multiplyStrassen(Matrix& other, bool useOpenCL, int cutoff) {
+    if (cols != other.rows) {
+        return Matrix<ResultType>();
     }
 
-    bufferA = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                             sizeof(int) * rows * cols, tempBufferA.data(), nullptr);
+    if (useOpenCL && !OpenCLRuntime::instance().isAvailable()) {
+        return Matrix<ResultType>();
+    }
+    if (useOpenCL && !OpenCLElement<ResultType>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<ResultType>::name() << " matrices." << std::endl;
+        return Matrix<ResultType>();
+    }
 
-    bufferB = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
-                             sizeof(int) * other.rows * other.cols, tempBufferB.data(), nullptr);
+    Matrix<ResultType> result(rows, other.cols);
+    if (!result.storage) {
+        return result;
+    }
 
-    bufferResult = clCreateBuffer(context, CL_MEM_WRITE_ONLY,
-                                  sizeof(int) * rows * other.cols, nullptr, nullptr);
+    const Matrix& a = *this;
+    const Matrix& b = other;
+    PHY250_TIME_SCOPE("multiplyStrassen");
+    gemmStrassen(rows, cols, other.cols, a.data(), stride, b.data(), other.stride, result.data(), result.stride,
+                 useOpenCL, cutoff);
 
-    clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufferA);
-    clSetKernelArg(kernel, 1, sizeof(cl_mem), &bufferB);
-    clSetKernelArg(kernel, 2, sizeof(cl_mem), &bufferResult);
-    clSetKernelArg(kernel, 3, sizeof(int), &rows);
-    clSetKernelArg(kernel, 4, sizeof(int), &cols);
-    clSetKernelArg(kernel, 5, sizeof(int), &other.cols);
+    checkProduct(other, result, "multiplyStrassen", true);
+    return result;
+}
 
-    size_t globalWorkSize[2] = {static_cast<size_t>(rows), static_cast<size_t>(other.cols)};
-    size_t localWorkSize[2] = {1, 1}; // Adjust as needed
+template <typename T>
+Matrix<typename Matrix<T>::ResultType> Matrix<T>::multiplyHybrid(Matrix& other) {
+    if (cols != other.rows) {
+        return Matrix<ResultType>();
+    }
 
-    clEnqueueNDRangeKernel(commandQueue, kernel, 2, nullptr, globalWorkSize, nullptr, 0, nullptr, nullptr);
-    clFinish(commandQueue);
+    Matrix<ResultType> result(rows, other.cols);
+    if (!result.storage) {
+        return result;
+    }
 
-    std::vector<int> resultData(rows * other.cols);
-    clEnqueueReadBuffer(commandQueue, bufferResult, CL_TRUE, 0, sizeof(int) * rows * other.cols, resultData.data(), 0, nullptr, nullptr);
+    const Matrix& a = *this;
+    const Matrix& b = other;
+    PHY250_TIME_SCOPE("multiplyHybrid");
+    gemmHybrid(rows, cols, other.cols, a.data(), stride, b.data(), other.stride, result.data(), result.stride);
 
-    clReleaseMemObject(bufferA);
-    clReleaseMemObject(bufferB);
-    clReleaseMemObject(bufferResult);
+    checkProduct(other, result, "multiplyHybrid");
+    return result;
+}
 
-    std::vector<std::vector<int>> resultMatrix(rows, std::vector<int>(other.cols));
-    for (int i = 0; i < rows; ++i) {
-        for (int j = 0; j < other.cols; ++j) {
-            resultMatrix[i][j] = resultData[i * other.cols + j];
-        }
+template <typename T>
+Matrix<typename Matrix<T>::ResultType> Matrix<T>::multiplyMultiDevice(Matrix& other) {
+    if (cols != other.rows) {
+        return Matrix<ResultType>();
+    }
+
+    Matrix<ResultType> result(rows, other.cols);
+    if (!result.storage) {
+        return result;
     }
 
-    return Matrix(rows, other.cols, resultMatrix);
+    const Matrix& a = *this;
+    const Matrix& b = other;
+    GemmJob<T, ResultType> job = {rows, cols, other.cols, a.data(), stride, b.data(), other.stride,
+                                  result.data(), result.stride};
+    PHY250_TIME_SCOPE("multiplyMultiDevice");
+    DeviceGroup::instance().gemm(job);
+
+    checkProduct(other, result, "multiplyMultiDevice");
+    return result;
+}
+
+template <typename T>
+std::vector<Matrix<typename Matrix<T>::ResultType>> Matrix<T>::multiplyMultiDeviceBatch(const std::vector<Matrix>& lhs,
+                                                                                        const std::vector<Matrix>& rhs) {
+    size_t count = std::min(lhs.size(), rhs.size());
+    std::vector<Matrix<ResultType>> results(count);
+    std::vector<GemmJob<T, ResultType>> jobs;
+    for (size_t i = 0; i < count; ++i) {
+        const Matrix& a = lhs[i];
+        const Matrix& b = rhs[i];
+        if (a.cols != b.rows) {
+            continue;
+        }
+        results[i] = Matrix<ResultType>(a.rows, b.cols);
+        if (!results[i].storage) {
+            continue;
+        }
+        GemmJob<T, ResultType> job = {a.rows, a.cols, b.cols, a.data(), a.stride, b.data(), b.stride,
+                                      results[i].data(), results[i].stride};
+        jobs.push_back(job);
+    }
+    DeviceGroup::instance().gemmBatch(jobs);
+    for (size_t i = 0; i < count; ++i) {
+        lhs[i].checkProduct(rhs[i], results[i], "multiplyMultiDeviceBatch");
+    }
+    return results;
 }
 
-void Matrix::print() const {
+template <typename T>
+Matrix<typename Matrix<T>::ResultType> Matrix<T>::multiply(Matrix& other, bool useOpenCL) {
+    if (cols != other.rows) {
+        return Matrix<ResultType>();
+    }
+
+    const Matrix& a = *this;
+    size_t nonZeros = 0;
     for (int i = 0; i < rows; ++i) {
+        const T* row = a.row(i);
         for (int j = 0; j < cols; ++j) {
-            std::cout << data[i][j] << " ";
+            nonZeros += row[j] != T(0);
+        }
+    }
+
+    if (rows > 0 && cols > 0 && static_cast<double>(nonZeros) / rows / cols < sparseDensityThreshold) {
+        return SparseMatrix<T>::fromDense(*this).multiply(other, useOpenCL);
+    }
+    return useOpenCL ? multiplyOpenCL(other) : multiplyCPU(other);
+}
+
+template <typename T>
+bool Matrix<T>::verifyProduct(const Matrix& other, const Matrix<ResultType>& product, int trials, bool useOpenCL,
+                              std::vector<int>* mismatchedRows, bool normwise) const {
+    if (mismatchedRows != nullptr) {
+        mismatchedRows->clear();
+    }
+    if (cols != other.rows || product.rows != rows || product.cols != other.cols) {
+        std::cerr << "Error: Product has the wrong shape to verify." << std::endl;
+        return false;
+    }
+    if (!storage || !other.storage || !product.storage) {
+        return rows == 0 || other.cols == 0;
+    }
+
+    std::vector<int> failed;
+    bool checked = false;
+    if (useOpenCL && OpenCLRuntime::instance().isAvailable()) {
+        upload();
+        other.upload();
+        product.upload();
+        if (deviceValid && other.deviceValid && product.deviceValid) {
+            checked = verifyGemmOpenCL<T, ResultType>(rows, cols, other.cols, deviceBuffer, stride,
+                                                      other.deviceBuffer, other.stride, product.deviceBuffer,
+                                                      product.stride, trials, normwise, failed);
+        }
+    }
+    if (!checked) {
+        failed = verifyGemmCPU(rows, cols, other.cols, data(), stride, other.data(), other.stride, product.data(),
+                               product.stride, trials, normwise);
+    }
+
+    if (mismatchedRows != nullptr) {
+        *mismatchedRows = failed;
+    }
+    return failed.empty();
+}
+
+template <typename T>
+void Matrix<T>::checkProduct(const Matrix& other, Matrix<ResultType>& product, const char* method,
+                             bool normwise) const {
+    static const int trials = verifyTrialsFromEnvironment();
+    if (trials == 0 || !product.storage) {
+        return;
+    }
+
+    // A product only on the device is checked there, so it is not read back
+    std::vector<int> failed;
+    if (verifyProduct(other, product, trials, !product.hostValid, &failed, normwise)) {
+        return;
+    }
+    repairRows(method, failed, cols, other.cols, data(), stride, other.data(), other.stride, product.data(),
+               product.stride);
+}
+
+template <typename T>
+Matrix<typename Matrix<T>::ResultType> Matrix<T>::multiplyOpenCL(Matrix& other){
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    cl_context context = runtime.getContext();
+    cl_command_queue commandQueue = runtime.getQueue();
+    if (context == nullptr || commandQueue == nullptr) {
+        return Matrix<ResultType>();
+    }
+
+    if (!OpenCLElement<T>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<T>::name() << " matrices." << std::endl;
+        return Matrix<ResultType>();
+    }
+
+    if (cols != other.rows) {
+        return Matrix<ResultType>();
+    }
+
+    if (!storage || !other.storage) {
+        return Matrix<ResultType>();
+    }
+
+    // Enqueueing only; the kernel time shows up in whatever waits for it
+    PHY250_TIME_SCOPE("multiplyOpenCL");
+    Matrix<ResultType> result(rows, other.cols);
+    if (!result.storage) {
+        return Matrix<ResultType>();
+    }
+
+    // Operands already on the device are used in place; the result stays
+    // there until something reads it on the host.
+    upload();
+    other.upload();
+    cl_mem bufferA = deviceValid ? deviceBuffer : nullptr;
+    cl_mem bufferB = other.deviceValid ? other.deviceBuffer : nullptr;
+    cl_mem bufferResult = result.getDeviceBuffer();
+    if (bufferA == nullptr || bufferB == nullptr || bufferResult == nullptr) {
+        return Matrix<ResultType>();
+    }
+
+    GemmConfig config = GemmAutotuner::instance().getConfig<T, ResultType>(rows, cols, other.cols);
+    cl_int error = enqueueGemm<T, ResultType>(config, bufferA, bufferB, bufferResult, rows, cols, other.cols, stride, other.stride, result.stride);
+    if (error != CL_SUCCESS && config.isTiled()) {
+        // The device rejected the tiled launch (e.g. work-group too large for
+        // this kernel), so fall back to the untiled kernel.
+        error = enqueueGemm<T, ResultType>(GemmConfig(), bufferA, bufferB, bufferResult, rows, cols, other.cols, stride, other.stride, result.stride);
+    }
+    if (error != CL_SUCCESS) {
+        std::cerr << "ERROR Enqueueing kernel" << std::endl;
+        return Matrix<ResultType>();
+    }
+    clFlush(commandQueue);
+
+    deviceBusy = true;
+    other.deviceBusy = true;
+    result.deviceBusy = true;
+    result.deviceValid = true;
+    result.hostValid = false;
+    checkProduct(other, result, "multiplyOpenCL");
+    return result;
+}
+
+template <typename T>
+struct MatrixFuture<T>::State {
+    Matrix<T> result;
+    cl_event done;
+
+    // Operand storage, kept alive until the uploads have read it
+    std::shared_ptr<const void> operands[2];
+
+    // With PHY250_VERIFY set, checks the result on the host in get()
+    std::function<void(Matrix<T>&)> check;
+
+    State() : done(nullptr) {
+    }
+
+    // The device may still be writing result, so wait before freeing it
+    ~State() {
+        if (done) {
+            clWaitForEvents(1, &done);
+            clReleaseEvent(done);
         }
-        std::cout << "\n";
     }
+};
+
+template <typename T>
+MatrixFuture<T>::MatrixFuture() {
+}
+
+template <typename T>
+bool MatrixFuture<T>::isValid() const {
+    return state != nullptr;
+}
+
+template <typename T>
+bool MatrixFuture<T>::isReady() const {
+    if (!state || !state->done) {
+        return true;
+    }
+    cl_int status = CL_QUEUED;
+    clGetEventInfo(state->done, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, nullptr);
+    return status == CL_COMPLETE || status < 0;
+}
+
+template <typename T>
+void MatrixFuture<T>::wait() const {
+    if (state && state->done) {
+        clWaitForEvents(1, &state->done);
+    }
+}
+
+template <typename T>
+Matrix<T> MatrixFuture<T>::get() {
+    if (!state) {
+        return Matrix<T>();
+    }
+    wait();
+    if (state->check) {
+        state->check(state->result);
+        state->check = nullptr;
+    }
+    return std::move(state->result);
+}
+
+template <typename T>
+cl_event MatrixFuture<T>::getEvent() const {
+    return state ? state->done : nullptr;
+}
+
+template <typename T>
+MatrixFuture<typename Matrix<T>::ResultType> Matrix<T>::submitOpenCL(const Matrix& other) const {
+    MatrixFuture<ResultType> future;
+    if (!OpenCLRuntime::instance().isAvailable() || cols != other.rows || !storage || !other.storage) {
+        return future;
+    }
+    if (!OpenCLElement<T>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<T>::name() << " matrices." << std::endl;
+        return future;
+    }
+
+    auto state = std::make_shared<typename MatrixFuture<ResultType>::State>();
+    state->result = Matrix<ResultType>(rows, other.cols);
+    if (!state->result.storage) {
+        return future;
+    }
+
+    // The uploads read the operands' host storage after this returns, so
+    // later host writes to either operand wait for them.
+    state->done = AsyncGemm::instance().submit<T, ResultType>(rows, cols, other.cols, data(), stride, other.data(), other.stride,
+                                                              state->result.storage.get(), state->result.stride);
+    if (state->done == nullptr) {
+        return future;
+    }
+    state->operands[0] = storage;
+    state->operands[1] = other.storage;
+
+    // The operands may change before get(), so the check runs against
+    // copies of them as they were multiplied
+    static const int trials = verifyTrialsFromEnvironment();
+    if (trials > 0) {
+        auto operands = std::make_shared<std::pair<Matrix, Matrix>>(*this, other);
+        state->check = [operands](Matrix<ResultType>& result) {
+            operands->first.checkProduct(operands->second, result, "MatrixFuture::get");
+        };
+    }
+    deviceBusy = true;
+    other.deviceBusy = true;
+    future.state = state;
+    return future;
+}
+
+template <typename T>
+MatrixFuture<typename Matrix<T>::ResultType> Matrix<T>::multiplyOpenCLAsync(const Matrix& other) const {
+    MatrixFuture<ResultType> future = submitOpenCL(other);
+    AsyncGemm::instance().flush();
+    return future;
+}
+
+template <typename T>
+std::vector<MatrixFuture<typename Matrix<T>::ResultType>> Matrix<T>::multiplyOpenCLBatch(const std::vector<Matrix>& lhs,
+                                                                                         const std::vector<Matrix>& rhs) {
+    std::vector<MatrixFuture<ResultType>> futures;
+    size_t count = std::min(lhs.size(), rhs.size());
+    futures.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        futures.push_back(lhs[i].submitOpenCL(rhs[i]));
+    }
+    AsyncGemm::instance().flush();
+    return futures;
+}
+
+template <typename T>
+void Matrix<T>::print() const {
+    writeText(*this, std::cout);
 }
 
+template class Matrix<float>;
+template class Matrix<double>;
+template class Matrix<int32_t>;
+template class Matrix<int64_t>;
+template class Matrix<int8_t>;
+
+template class MatrixView<float>;
+template class MatrixView<double>;
+template class MatrixView<int32_t>;
+template class MatrixView<int64_t>;
+template class MatrixView<int8_t>;
+
+template class MatrixFuture<float>;
+template class MatrixFuture<double>;
+template class MatrixFuture<int32_t>;
+template class MatrixFuture<int64_t>;
@@ -3,26 +3,52 @@
 // 2023-03-13
 //
 
-#define CL_TARGET_OPENCL_VERSION 120
-
 #ifndef MATRIX_HPP
 #define MATRIX_HPP
 
+#include <cstdint>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <vector>
 
-#ifdef __APPLE__
-#include <OpenCL/opencl.h>
-#else
-#include <CL/cl.h>
-#endif
+#include "opencl_runtime.hpp"
+
+// Element type that products of T accumulate into. Quantized int8 inputs
+// accumulate in int32 so sums of products cannot overflow.
+template <typename T>
+struct Accumulator {
+    typedef T type;
+};
+
+template <>
+struct Accumulator<int8_t> {
+    typedef int32_t type;
+};
+
+template <typename T>
+class MatrixFuture;
+
+template <typename T>
+class SparseMatrix;
 
+template <typename T>
+class MatrixView;
+
+template <typename T>
+class GemmExpr;
+
+// Dense row-major matrix. Instantiated for float, double, int32_t, int64_t
+// and int8_t.
+template <typename T>
 class Matrix {
 public:
+    typedef typename Accumulator<T>::type ResultType;
+
     // Constructors
     Matrix();
     Matrix(int rows, int cols);
-    Matrix(int rows, int cols, const std::vector<std::vector<int>>& data);
+    Matrix(int rows, int cols, const std::vector<std::vector<T>>& data);
 
     // Destructor
     ~Matrix();
@@ -30,46 +56,208 @@ public:
     // Copy constructor
     Matrix(const Matrix& other);
 
-    // Assignment operator
+    // Move constructor
+    Matrix(Matrix&& other);
+
+    // Assignment operators
     Matrix& operator=(const Matrix& other);
+    Matrix& operator=(Matrix&& other);
 
     // Accessor methods
     int getRows() const;
     int getCols() const;
-    int getElement(int row, int col) const;
+    int getStride() const;
+    T getElement(int row, int col) const;
+
+    // Row stride, in elements, of a matrix with cols columns
+    static int strideFor(int cols);
+
+    // Raw access to the contiguous row-major buffer. Row r starts at
+    // data() + r * getStride(); the padding past getCols() is zero.
+    // These download the matrix first if only the device copy is current,
+    // and the non-const versions mark the device copy stale.
+    T* data();
+    const T* data() const;
+    T* row(int r);
+    const T* row(int r) const;
 
     // Mutator methods
-    void setElement(int row, int col, int value);
+    void setElement(int row, int col, T value);
 
     // Matrix operations
-    Matrix transpose() const;
-    Matrix multiplyCPU(Matrix& other) ;
-    Matrix multiplyOpenCL(Matrix& other);
+
+    // The transpose as a view with rows and columns swapped; nothing is
+    // copied. Multiplies and expressions (see matrix_expr.hpp) read it in
+    // place, and assigning it to a Matrix makes the copy.
+    MatrixView<T> transpose() const;
+    Matrix<ResultType> multiplyCPU(Matrix& other) ;
+    Matrix<ResultType> multiplyOpenCL(Matrix& other);
+
+    // Strassen-Winograd multiply: about n^2.81 work instead of n^3 for large
+    // matrices. Blocks below cutoff go to the multiplyCPU kernel, or to the
+    // OpenCL device when useOpenCL is set; cutoff 0 picks one automatically.
+    // Exact for integers; floating-point results can differ slightly from
+    // multiplyCPU.
+    Matrix<ResultType> multiplyStrassen(Matrix& other, bool useOpenCL = false, int cutoff = 0);
+
+    // Splits the rows of the result between the CPU and the OpenCL device
+    // and runs both at once, balancing the split by how fast each side
+    // turns out to be. Falls back to multiplyCPU without a usable device.
+    Matrix<ResultType> multiplyHybrid(Matrix& other);
+
+    // Splits the rows of the result between every OpenCL device selected by
+    // PHY250_CL_DEVICES, in proportion to how fast each one is
+    Matrix<ResultType> multiplyMultiDevice(Matrix& other);
+
+    // lhs[i] * rhs[i] for every i, each product run whole on one of the
+    // selected devices. Mismatched pairs give empty matrices.
+    static std::vector<Matrix<ResultType>> multiplyMultiDeviceBatch(const std::vector<Matrix>& lhs,
+                                                                    const std::vector<Matrix>& rhs);
+
+    // Counts this matrix's nonzeros and multiplies it as a SparseMatrix when
+    // it is sparse enough to pay off, otherwise like multiplyCPU or
+    // multiplyOpenCL
+    Matrix<ResultType> multiply(Matrix& other, bool useOpenCL = false);
+
+    // Checks that product == *this * other with Freivalds' algorithm (see
+    // verify.hpp) in O(trials * n^2), without multiplying again; trials 0
+    // means defaultVerifyTrials. Returns false if any row fails, and lists
+    // the rows that failed in mismatchedRows if given. With useOpenCL the
+    // check runs on the device, in place for matrices already there, and
+    // falls back to the CPU if the device cannot run it. Set normwise for
+    // products of multiplyStrassen.
+    bool verifyProduct(const Matrix& other, const Matrix<ResultType>& product, int trials = 0,
+                       bool useOpenCL = false, std::vector<int>* mismatchedRows = nullptr,
+                       bool normwise = false) const;
+
+    // Asynchronous multiplies for many independent products. Each one is
+    // read from the host and goes to the next OpenCL queue, so transfers and
+    // kernels of different products overlap; get() on the future waits for
+    // the result. The operands may be changed or destroyed at any time;
+    // with PHY250_VERIFY set they are copied here for the check in get().
+    MatrixFuture<ResultType> multiplyOpenCLAsync(const Matrix& other) const;
+
+    // Submits lhs[i] * rhs[i] for every i before waiting on any of them
+    static std::vector<MatrixFuture<ResultType>> multiplyOpenCLBatch(const std::vector<Matrix>& lhs,
+                                                                     const std::vector<Matrix>& rhs);
 
     // Print matrix
     void print() const;
 
+    // Device residency. A matrix used by multiplyOpenCL keeps a device copy,
+    // and OpenCL results stay on the device until the host reads them, so
+    // chained multiplies run without transfers. Transfers happen on demand;
+    // upload() and download() only control when.
+    void upload() const;
+    void download() const;
+    bool isOnHost() const;
+    bool isOnDevice() const;
+
 private:
+    template <typename U>
+    friend class Matrix;
+    template <typename U>
+    friend class SparseMatrix;
+    template <typename U>
+    friend class GemmExpr;
+    template <typename U>
+    friend Matrix<U> loadMatrix(const std::string& path);
+
     int rows;
     int cols;
-    std::vector<std::vector<int>> data;
+    int stride;
+    std::shared_ptr<T> storage;
+
+    // Device copy of storage, created on first OpenCL use. hostValid and
+    // deviceValid say which copies are current; deviceBusy is set while
+    // queued commands may still be using the buffer.
+    mutable cl_mem deviceBuffer;
+    mutable bool hostValid;
+    mutable bool deviceValid;
+    mutable bool deviceBusy;
+
+    // Allocates zeroed, aligned storage for the current rows/cols
+    void allocate();
 
-    // OpenCL variables
-    cl_platform_id platform;
-    cl_device_id device;
-    cl_context context;
-    cl_program program;
-    cl_kernel kernel;
+    // Returns the device buffer, creating it if needed. The contents are
+    // only current if deviceValid is set.
+    cl_mem getDeviceBuffer() const;
 
-    // OpenCL buffers
-    cl_mem bufferA;
-    cl_mem bufferB;
-    cl_mem bufferResult;
+    // Waits for queued commands using the device buffer
+    void waitForDevice() const;
 
-    cl_command_queue commandQueue;
+    // Makes the host copy current before reading it
+    void syncHost() const;
+
+    // Makes the host copy current and the device copy stale before writing it
+    void prepareHostWrite();
+
+    // Copies the contents of other, which has the same shape
+    void copyFrom(const Matrix& other);
+
+    void releaseDevice();
+
+    // With PHY250_VERIFY set, verifies a product of this and other made by
+    // method, on the device if it is only there, and recomputes any rows
+    // that fail on the CPU
+    void checkProduct(const Matrix& other, Matrix<ResultType>& product, const char* method,
+                      bool normwise = false) const;
+
+    // Enqueues an asynchronous multiply without flushing the queues
+    MatrixFuture<ResultType> submitOpenCL(const Matrix& other) const;
+};
+
+// Read-only view of a matrix or of its transpose. A transposed view swaps
+// the row and column strides instead of moving elements. The view refers to
+// the matrix, which must outlive it.
+template <typename T>
+class MatrixView {
+public:
+    MatrixView(const Matrix<T>& matrix, bool transposed = false);
+
+    int getRows() const;
+    int getCols() const;
+    T getElement(int row, int col) const;
+
+    bool isTransposed() const;
+    const Matrix<T>& getMatrix() const;
+
+    MatrixView transpose() const;
+
+    // Copies the viewed elements into a new matrix
+    operator Matrix<T>() const;
+
+private:
+    const Matrix<T>* matrix;
+    bool transposed;
+};
+
+// Result of an asynchronous multiply
+template <typename T>
+class MatrixFuture {
+public:
+    MatrixFuture();
+
+    // False if the multiply could not be submitted
+    bool isValid() const;
+
+    // True once the result is in host memory; never blocks
+    bool isReady() const;
+
+    void wait() const;
+
+    // Waits for and returns the result. Only the first call returns it.
+    Matrix<T> get();
+
+    // Event that completes with the multiply, for clWaitForEvents
+    cl_event getEvent() const;
+
+private:
+    template <typename U>
+    friend class Matrix;
 
-    // OpenCL initialization
-    void initializeOpenCL();
+    struct State;
+    std::shared_ptr<State> state;
 };
 
 #endif // MATRIX_H
@@ -0,0 +1,221 @@
+// matrix_expr.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "matrix_expr.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_gemm.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+template <typename T>
+GemmExpr<T>::GemmExpr(const MatrixView<T>& a, const MatrixView<T>& b, ResultType alpha)
+    : a(a), b(b), alpha(alpha), beta(0), addend(nullptr), addendTransposed(false), fusable(true) {
+}
+
+template <typename T>
+int GemmExpr<T>::getRows() const {
+    return a.getRows();
+}
+
+template <typename T>
+int GemmExpr<T>::getCols() const {
+    return b.getCols();
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::add(const MatrixView<ResultType>& d, ResultType factor) const {
+    GemmExpr result = *this;
+    if (addend != nullptr || !ops.empty()) {
+        std::cerr << "Error: Only one matrix can be added to a product, before any elementwise op." << std::endl;
+        result.fusable = false;
+        return result;
+    }
+    result.addend = &d.getMatrix();
+    result.addendTransposed = d.isTransposed();
+    result.beta = factor;
+    return result;
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::scale(ResultType factor) const {
+    if (!ops.empty()) {
+        return withOp(PostOp<ResultType>::Multiply, factor, 0);
+    }
+    GemmExpr result = *this;
+    result.alpha *= factor;
+    result.beta *= factor;
+    return result;
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::relu() const {
+    return withOp(PostOp<ResultType>::Relu, 0, 0);
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::clamp(ResultType low, ResultType high) const {
+    return withOp(PostOp<ResultType>::Clamp, low, high);
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::abs() const {
+    return withOp(PostOp<ResultType>::Abs, 0, 0);
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::shift(ResultType offset) const {
+    return withOp(PostOp<ResultType>::Add, offset, 0);
+}
+
+template <typename T>
+GemmExpr<T> GemmExpr<T>::withOp(typename PostOp<ResultType>::Kind kind, ResultType first, ResultType second) const {
+    GemmExpr result = *this;
+    PostOp<ResultType> op;
+    op.kind = kind;
+    op.first = first;
+    op.second = second;
+    result.ops.push_back(op);
+    return result;
+}
+
+template <typename T>
+bool GemmExpr<T>::checkShapes() const {
+    if (!fusable || a.getCols() != b.getRows()) {
+        return false;
+    }
+    if (addend == nullptr) {
+        return true;
+    }
+    MatrixView<ResultType> d(*addend, addendTransposed);
+    return d.getRows() == getRows() && d.getCols() == getCols();
+}
+
+template <typename T>
+GemmEpilogue<typename GemmExpr<T>::ResultType> GemmExpr<T>::epilogue(const ResultType* addendData) const {
+    GemmEpilogue<ResultType> result;
+    result.alpha = alpha;
+    result.ops = ops.data();
+    result.opCount = static_cast<int>(ops.size());
+    if (addend != nullptr) {
+        result.beta = beta;
+        result.addend = addendData;
+        result.addendRowStride = addendTransposed ? 1 : addend->stride;
+        result.addendColStride = addendTransposed ? addend->stride : 1;
+    }
+    return result;
+}
+
+template <typename T>
+Matrix<typename GemmExpr<T>::ResultType> GemmExpr<T>::evaluateCPU() const {
+    if (!checkShapes()) {
+        return Matrix<ResultType>();
+    }
+
+    PHY250_TIME_SCOPE("evaluateCPU");
+    Matrix<ResultType> result(getRows(), getCols());
+    if (!result.storage) {
+        return result;
+    }
+
+    const Matrix<T>& matrixA = a.getMatrix();
+    const Matrix<T>& matrixB = b.getMatrix();
+    gemmCPU(getRows(), a.getCols(), getCols(),
+            matrixA.data(), matrixA.stride, a.isTransposed(),
+            matrixB.data(), matrixB.stride, b.isTransposed(),
+            result.data(), result.stride, epilogue(addend != nullptr ? addend->data() : nullptr));
+
+    return result;
+}
+
+template <typename T>
+Matrix<typename GemmExpr<T>::ResultType> GemmExpr<T>::evaluateOpenCL() const {
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    cl_command_queue commandQueue = runtime.getQueue();
+    if (runtime.getContext() == nullptr || commandQueue == nullptr) {
+        return Matrix<ResultType>();
+    }
+    if (!OpenCLElement<T>::isSupported() || !OpenCLElement<ResultType>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<T>::name() << " matrices." << std::endl;
+        return Matrix<ResultType>();
+    }
+    if (!checkShapes()) {
+        return Matrix<ResultType>();
+    }
+
+    PHY250_TIME_SCOPE("evaluateOpenCL");
+    Matrix<ResultType> result(getRows(), getCols());
+    if (!result.storage) {
+        return Matrix<ResultType>();
+    }
+
+    // Like multiplyOpenCL, operands already on the device are used in place
+    // and the result stays there
+    const Matrix<T>& matrixA = a.getMatrix();
+    const Matrix<T>& matrixB = b.getMatrix();
+    matrixA.upload();
+    matrixB.upload();
+    cl_mem bufferA = matrixA.deviceValid ? matrixA.deviceBuffer : nullptr;
+    cl_mem bufferB = matrixB.deviceValid ? matrixB.deviceBuffer : nullptr;
+    cl_mem bufferAddend = nullptr;
+    if (addend != nullptr) {
+        addend->upload();
+        bufferAddend = addend->deviceValid ? addend->deviceBuffer : nullptr;
+    }
+    cl_mem bufferResult = result.getDeviceBuffer();
+    if (bufferA == nullptr || bufferB == nullptr || bufferResult == nullptr ||
+        (addend != nullptr && bufferAddend == nullptr)) {
+        return Matrix<ResultType>();
+    }
+
+    const int rows = getRows();
+    const int inner = a.getCols();
+    const int cols = getCols();
+    GemmEpilogue<ResultType> fused = epilogue(nullptr);
+    GemmConfig config = GemmAutotuner::instance().getConfig<T, ResultType>(rows, inner, cols);
+    cl_int error = enqueueGemmFused<T, ResultType>(config, a.isTransposed(), b.isTransposed(), fused,
+                                                   bufferA, bufferB, bufferResult, bufferAddend, rows, inner, cols,
+                                                   matrixA.stride, matrixB.stride, result.stride);
+    if (error != CL_SUCCESS && config.isTiled()) {
+        error = enqueueGemmFused<T, ResultType>(GemmConfig(), a.isTransposed(), b.isTransposed(), fused,
+                                                bufferA, bufferB, bufferResult, bufferAddend, rows, inner, cols,
+                                                matrixA.stride, matrixB.stride, result.stride);
+    }
+    if (error != CL_SUCCESS) {
+        std::cerr << "ERROR Enqueueing kernel" << std::endl;
+        return Matrix<ResultType>();
+    }
+    clFlush(commandQueue);
+
+    matrixA.deviceBusy = true;
+    matrixB.deviceBusy = true;
+    if (addend != nullptr) {
+        addend->deviceBusy = true;
+    }
+    result.deviceBusy = true;
+    result.deviceValid = true;
+    result.hostValid = false;
+    if (fused.isIdentity() && !a.isTransposed() && !b.isTransposed()) {
+        matrixA.checkProduct(matrixB, result, "evaluateOpenCL");
+    }
+    return result;
+}
+
+template <typename T>
+Matrix<typename GemmExpr<T>::ResultType> GemmExpr<T>::evaluate(bool useOpenCL) const {
+    return useOpenCL ? evaluateOpenCL() : evaluateCPU();
+}
+
+template <typename T>
+GemmExpr<T>::operator Matrix<ResultType>() const {
+    return evaluateCPU();
+}
+
+template class GemmExpr<float>;
+template class GemmExpr<double>;
+template class GemmExpr<int32_t>;
+template class GemmExpr<int64_t>;
+template class GemmExpr<int8_t>;
@@ -0,0 +1,165 @@
+// matrix_expr.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef MATRIX_EXPR_HPP
+#define MATRIX_EXPR_HPP
+
+#include <vector>
+
+#include "gemm_epilogue.hpp"
+#include "matrix.hpp"
+
+// A view times a constant, such as 2 * A, waiting to become part of an
+// expression
+template <typename T>
+struct ScaledView {
+    typename Matrix<T>::ResultType factor;
+    MatrixView<T> view;
+};
+
+// Lazily evaluated ops(alpha * op(A) * op(B) + beta * op(D)), built with the
+// operators below:
+//
+//     Matrix<float> E = (2.0f * A * B.transpose() + 0.5f * C).relu();
+//
+// Nothing is computed until the expression is assigned to a Matrix or
+// evaluated. Then the product, scaling, sum and ops are done in one pass
+// (on the device, one kernel) with no temporary matrices, and transposed
+// operands are read in place. Assigning evaluates on the CPU.
+//
+// Only one matrix can be added, and only before any op; a sum or product
+// that cannot be fused prints an error and evaluates to an empty matrix.
+// The expression refers to its matrices, which must outlive it.
+template <typename T>
+class GemmExpr {
+public:
+    typedef typename Matrix<T>::ResultType ResultType;
+
+    GemmExpr(const MatrixView<T>& a, const MatrixView<T>& b, ResultType alpha = 1);
+
+    int getRows() const;
+    int getCols() const;
+
+    // Adds beta * D
+    GemmExpr add(const MatrixView<ResultType>& addend, ResultType beta = 1) const;
+
+    // Multiplies the whole expression by factor
+    GemmExpr scale(ResultType factor) const;
+
+    // Elementwise ops on the result, applied in the order they are added
+    GemmExpr relu() const;
+    GemmExpr clamp(ResultType low, ResultType high) const;
+    GemmExpr abs() const;
+    GemmExpr shift(ResultType offset) const;
+
+    // Computes the expression into a new matrix. Empty if the shapes do not
+    // match. The OpenCL result stays on the device like multiplyOpenCL's.
+    Matrix<ResultType> evaluateCPU() const;
+    Matrix<ResultType> evaluateOpenCL() const;
+    Matrix<ResultType> evaluate(bool useOpenCL = false) const;
+
+    operator Matrix<ResultType>() const;
+
+private:
+    GemmExpr withOp(typename PostOp<ResultType>::Kind kind, ResultType first, ResultType second) const;
+    bool checkShapes() const;
+
+    // The epilogue for the expression, with D at addendData
+    GemmEpilogue<ResultType> epilogue(const ResultType* addendData) const;
+
+    MatrixView<T> a;
+    MatrixView<T> b;
+    ResultType alpha;
+    ResultType beta;
+    const Matrix<ResultType>* addend;  // nullptr if nothing is added
+    bool addendTransposed;
+    std::vector<PostOp<ResultType>> ops;
+    bool fusable;
+};
+
+// Products
+template <typename T>
+GemmExpr<T> operator*(const MatrixView<T>& a, const MatrixView<T>& b) {
+    return GemmExpr<T>(a, b);
+}
+
+template <typename T>
+GemmExpr<T> operator*(const Matrix<T>& a, const Matrix<T>& b) {
+    return GemmExpr<T>(a, b);
+}
+
+template <typename T>
+GemmExpr<T> operator*(const Matrix<T>& a, const MatrixView<T>& b) {
+    return GemmExpr<T>(a, b);
+}
+
+template <typename T>
+GemmExpr<T> operator*(const MatrixView<T>& a, const Matrix<T>& b) {
+    return GemmExpr<T>(a, b);
+}
+
+template <typename T>
+GemmExpr<T> operator*(const ScaledView<T>& a, const MatrixView<T>& b) {
+    return GemmExpr<T>(a.view, b, a.factor);
+}
+
+template <typename T>
+GemmExpr<T> operator*(const ScaledView<T>& a, const Matrix<T>& b) {
+    return GemmExpr<T>(a.view, b, a.factor);
+}
+
+// Scaling
+template <typename T>
+ScaledView<T> operator*(typename Matrix<T>::ResultType factor, const Matrix<T>& a) {
+    return ScaledView<T>{factor, MatrixView<T>(a)};
+}
+
+template <typename T>
+ScaledView<T> operator*(typename Matrix<T>::ResultType factor, const MatrixView<T>& a) {
+    return ScaledView<T>{factor, a};
+}
+
+template <typename T>
+GemmExpr<T> operator*(typename GemmExpr<T>::ResultType factor, const GemmExpr<T>& e) {
+    return e.scale(factor);
+}
+
+template <typename T>
+GemmExpr<T> operator*(const GemmExpr<T>& e, typename GemmExpr<T>::ResultType factor) {
+    return e.scale(factor);
+}
+
+// Sums. A constant is added to every element.
+template <typename T>
+GemmExpr<T> operator+(const GemmExpr<T>& e, const Matrix<typename GemmExpr<T>::ResultType>& d) {
+    return e.add(d);
+}
+
+template <typename T>
+GemmExpr<T> operator+(const GemmExpr<T>& e, const MatrixView<typename GemmExpr<T>::ResultType>& d) {
+    return e.add(d);
+}
+
+template <typename T>
+GemmExpr<T> operator+(const GemmExpr<T>& e, const ScaledView<typename GemmExpr<T>::ResultType>& d) {
+    return e.add(d.view, d.factor);
+}
+
+template <typename T>
+GemmExpr<T> operator-(const GemmExpr<T>& e, const Matrix<typename GemmExpr<T>::ResultType>& d) {
+    return e.add(d, -1);
+}
+
+template <typename T>
+GemmExpr<T> operator-(const GemmExpr<T>& e, const ScaledView<typename GemmExpr<T>::ResultType>& d) {
+    return e.add(d.view, -d.factor);
+}
+
+template <typename T>
+GemmExpr<T> operator+(const GemmExpr<T>& e, typename GemmExpr<T>::ResultType offset) {
+    return e.shift(offset);
+}
+
+#endif // MATRIX_EXPR_HPP
@@ -0,0 +1,462 @@
+// matrix_file.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "matrix_file.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_async.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char fileMagic[8] = "PHY250M";
+const uint32_t fileVersion = 1;
+
+// Payload offset: one page, so the mapped rows keep Matrix's page alignment
+const uint64_t fileDataOffset = 4096;
+
+template <typename T>
+struct FileElement;
+
+template <>
+struct FileElement<float> {
+    static const uint32_t code = 1;
+};
+
+template <>
+struct FileElement<double> {
+    static const uint32_t code = 2;
+};
+
+template <>
+struct FileElement<int32_t> {
+    static const uint32_t code = 3;
+};
+
+template <>
+struct FileElement<int64_t> {
+    static const uint32_t code = 4;
+};
+
+template <>
+struct FileElement<int8_t> {
+    static const uint32_t code = 5;
+};
+
+template <typename T>
+MatrixFileHeader makeHeader(int rows, int cols) {
+    MatrixFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, fileMagic, sizeof(header.magic));
+    header.version = fileVersion;
+    header.elementType = FileElement<T>::code;
+    header.rows = rows;
+    header.cols = cols;
+    header.stride = Matrix<T>::strideFor(cols);
+    header.dataOffset = fileDataOffset;
+    return header;
+}
+
+// Payload size of a header already checked by fileBytes
+size_t payloadBytes(const MatrixFileHeader& header, size_t elementSize) {
+    return elementSize * static_cast<size_t>(header.rows) * static_cast<size_t>(header.stride);
+}
+
+// Size of the whole file a header describes. Returns false if it does not
+// fit in size_t, as a corrupt header's rows and stride can make it.
+bool fileBytes(const MatrixFileHeader& header, size_t elementSize, size_t& bytes) {
+    if (header.rows < 0 || header.stride < 0) {
+        return false;
+    }
+    size_t payload;
+    return !__builtin_mul_overflow(elementSize, static_cast<uint64_t>(header.rows), &payload) &&
+           !__builtin_mul_overflow(payload, static_cast<uint64_t>(header.stride), &payload) &&
+           !__builtin_add_overflow(payload, header.dataOffset, &bytes);
+}
+
+// A whole file mapped into memory, unmapped on destruction
+struct MappedFile {
+    void* address = MAP_FAILED;
+    size_t length = 0;
+    dev_t device = 0;
+    ino_t inode = 0;
+
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+        if (address != MAP_FAILED) munmap(address, length);
+    }
+
+    const MatrixFileHeader& header() const {
+        return *static_cast<const MatrixFileHeader*>(address);
+    }
+
+    template <typename T>
+    T* data() const {
+        return reinterpret_cast<T*>(static_cast<char*>(address) + header().dataOffset);
+    }
+};
+
+// Maps an existing matrix file and checks its header against T
+template <typename T>
+bool mapMatrixFile(const std::string& path, int protection, int flags, MappedFile& file) {
+    int descriptor = open(path.c_str(), protection & PROT_WRITE && flags & MAP_SHARED ? O_RDWR : O_RDONLY);
+    if (descriptor < 0) {
+        std::cerr << "Error: Cannot open " << path << std::endl;
+        return false;
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || static_cast<size_t>(status.st_size) < sizeof(MatrixFileHeader)) {
+        std::cerr << "Error: " << path << " is not a matrix file." << std::endl;
+        close(descriptor);
+        return false;
+    }
+
+    file.length = static_cast<size_t>(status.st_size);
+    file.device = status.st_dev;
+    file.inode = status.st_ino;
+    file.address = mmap(nullptr, file.length, protection, flags, descriptor, 0);
+    close(descriptor);
+    if (file.address == MAP_FAILED) {
+        std::cerr << "Error: Cannot map " << path << std::endl;
+        return false;
+    }
+
+    const MatrixFileHeader& header = file.header();
+    if (std::memcmp(header.magic, fileMagic, sizeof(header.magic)) != 0 || header.version != fileVersion) {
+        std::cerr << "Error: " << path << " is not a matrix file." << std::endl;
+        return false;
+    }
+    if (header.elementType != FileElement<T>::code) {
+        std::cerr << "Error: " << path << " holds another element type." << std::endl;
+        return false;
+    }
+    size_t bytes = 0;
+    if (header.rows < 0 || header.cols < 0 || header.rows > INT32_MAX || header.cols > INT32_MAX ||
+        header.stride != Matrix<T>::strideFor(static_cast<int>(header.cols)) || header.dataOffset != fileDataOffset ||
+        !fileBytes(header, sizeof(T), bytes) || file.length < bytes) {
+        std::cerr << "Error: " << path << " has a corrupt header." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Creates path with room for a rows x cols matrix and maps it shared, so
+// stores go to the file
+template <typename T>
+bool createMatrixFile(const std::string& path, int rows, int cols, MappedFile& file) {
+    MatrixFileHeader header = makeHeader<T>(rows, cols);
+    if (!fileBytes(header, sizeof(T), file.length)) {
+        std::cerr << "Error: " << path << " would be too large." << std::endl;
+        return false;
+    }
+    int descriptor = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0) {
+        std::cerr << "Error: Cannot create " << path << std::endl;
+        return false;
+    }
+
+    bool created = ftruncate(descriptor, static_cast<off_t>(file.length)) == 0;
+    if (created) {
+        file.address = mmap(nullptr, file.length, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        created = file.address != MAP_FAILED;
+    }
+    close(descriptor);
+    if (!created) {
+        std::cerr << "Error: Cannot create " << path << std::endl;
+        return false;
+    }
+    std::memcpy(file.address, &header, sizeof(header));
+    return true;
+}
+
+// Widens a range of a mapping to whole pages, as madvise and msync need
+std::pair<void*, size_t> pageRange(const void* begin, size_t bytes) {
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    uintptr_t first = reinterpret_cast<uintptr_t>(begin) / page * page;
+    uintptr_t last = reinterpret_cast<uintptr_t>(begin) + bytes;
+    return {reinterpret_cast<void*>(first), last - first};
+}
+
+void adviseRange(const void* begin, size_t bytes, int advice) {
+    std::pair<void*, size_t> range = pageRange(begin, bytes);
+    madvise(range.first, range.second, advice);
+}
+
+size_t defaultMemoryBytes() {
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages <= 0 || pageSize <= 0) {
+        return size_t(1) << 30;
+    }
+    return static_cast<size_t>(pages) * static_cast<size_t>(pageSize) / 4;
+}
+
+} // namespace
+
+template <typename T>
+bool saveMatrix(const Matrix<T>& matrix, const std::string& path) {
+    MatrixFileHeader header = makeHeader<T>(matrix.getRows(), matrix.getCols());
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: Cannot create " << path << std::endl;
+        return false;
+    }
+
+    std::vector<char> prefix(header.dataOffset, 0);
+    std::memcpy(prefix.data(), &header, sizeof(header));
+    file.write(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+    if (matrix.getRows() > 0 && matrix.getCols() > 0) {
+        file.write(reinterpret_cast<const char*>(matrix.data()), static_cast<std::streamsize>(payloadBytes(header, sizeof(T))));
+    }
+
+    if (!file) {
+        std::cerr << "Error: Cannot write " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+Matrix<T> loadMatrix(const std::string& path) {
+    auto file = std::make_shared<MappedFile>();
+    if (!mapMatrixFile<T>(path, PROT_READ | PROT_WRITE, MAP_PRIVATE, *file)) {
+        return Matrix<T>();
+    }
+
+    Matrix<T> matrix;
+    matrix.rows = static_cast<int>(file->header().rows);
+    matrix.cols = static_cast<int>(file->header().cols);
+    matrix.stride = static_cast<int>(file->header().stride);
+    if (matrix.rows > 0 && matrix.cols > 0) {
+        // The storage keeps the mapping alive; the last reference unmaps it
+        matrix.storage = std::shared_ptr<T>(file, file->template data<T>());
+    } else {
+        matrix.rows = matrix.cols = matrix.stride = 0;
+    }
+    return matrix;
+}
+
+template <typename T>
+bool multiplyFiles(const std::string& pathA, const std::string& pathB, const std::string& pathC,
+                   bool useOpenCL, size_t memoryBytes) {
+    typedef typename Accumulator<T>::type Acc;
+    PHY250_TIME_SCOPE("multiplyFiles");
+
+    MappedFile fileA, fileB;
+    if (!mapMatrixFile<T>(pathA, PROT_READ, MAP_SHARED, fileA) || !mapMatrixFile<T>(pathB, PROT_READ, MAP_SHARED, fileB)) {
+        return false;
+    }
+    const int rows = static_cast<int>(fileA.header().rows);
+    const int inner = static_cast<int>(fileA.header().cols);
+    const int cols = static_cast<int>(fileB.header().cols);
+    if (inner != fileB.header().rows) {
+        std::cerr << "Error: " << pathA << " and " << pathB << " cannot be multiplied." << std::endl;
+        return false;
+    }
+    if (useOpenCL && !OpenCLRuntime::instance().isAvailable()) {
+        std::cerr << "Error: No OpenCL device to multiply " << pathA << " and " << pathB << "." << std::endl;
+        return false;
+    }
+
+    // Creating C truncates it, which would zero an input that is still
+    // mapped, or fault on reading it
+    struct stat existing;
+    if (stat(pathC.c_str(), &existing) == 0 &&
+        ((existing.st_dev == fileA.device && existing.st_ino == fileA.inode) ||
+         (existing.st_dev == fileB.device && existing.st_ino == fileB.inode))) {
+        std::cerr << "Error: " << pathC << " is also an input of the multiply." << std::endl;
+        return false;
+    }
+
+    MappedFile fileC;
+    if (!createMatrixFile<Acc>(pathC, rows, cols, fileC)) {
+        return false;
+    }
+    if (rows == 0 || inner == 0 || cols == 0) {
+        return true;
+    }
+
+    const T* A = fileA.data<T>();
+    const T* B = fileB.data<T>();
+    Acc* C = fileC.data<Acc>();
+    const int strideA = static_cast<int>(fileA.header().stride);
+    const int strideB = static_cast<int>(fileB.header().stride);
+    const int strideC = static_cast<int>(fileC.header().stride);
+    adviseRange(B, payloadBytes(fileB.header(), sizeof(T)), MADV_SEQUENTIAL);
+
+    // Partial products of one block. The CPU adds each block straight into
+    // C and needs none; OpenCL keeps two in flight so one block's transfers
+    // and kernel overlap the sum of the previous one.
+    const int slots = useOpenCL ? 2 : 0;
+
+    // Half the budget goes to a panel of A rows with the matching rows of C
+    // and of the partials, the other half to a block of B rows
+    if (memoryBytes == 0) {
+        memoryBytes = defaultMemoryBytes();
+    }
+    const size_t panelRowBytes = sizeof(T) * strideA + sizeof(Acc) * strideC * (1 + slots);
+    const int panelRows = static_cast<int>(std::clamp<size_t>(memoryBytes / 2 / panelRowBytes, 1, rows));
+    const size_t blockRowBytes = sizeof(T) * strideB;
+    int blockRows = static_cast<int>(std::clamp<size_t>(memoryBytes / 2 / blockRowBytes, 1, inner));
+    size_t partialBytes = sizeof(Acc) * static_cast<size_t>(panelRows) * strideC;
+    if (useOpenCL) {
+        // Each block also has to fit in one device buffer
+        cl_ulong maxAllocation = 0;
+        clGetDeviceInfo(OpenCLRuntime::instance().getDevice(), CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof(maxAllocation),
+                        &maxAllocation, nullptr);
+        if (maxAllocation > 0) {
+            blockRows = std::min<size_t>(blockRows, std::max<size_t>(maxAllocation / blockRowBytes, 1));
+            if (partialBytes > maxAllocation || sizeof(T) * static_cast<size_t>(panelRows) * strideA > maxAllocation) {
+                std::cerr << "Error: Rows of " << pathA << " do not fit on the device." << std::endl;
+                return false;
+            }
+        }
+    }
+
+    std::vector<std::vector<Acc>> partials(slots, std::vector<Acc>(partialBytes / sizeof(Acc)));
+    struct Pending {
+        cl_event done;
+        int slot;
+    };
+
+    for (int row = 0; row < rows; row += panelRows) {
+        const int height = std::min(panelRows, rows - row);
+        const T* panelA = A + static_cast<size_t>(row) * strideA;
+        Acc* panelC = C + static_cast<size_t>(row) * strideC;
+
+        std::deque<Pending> pending;
+        int slot = 0;
+        auto accumulate = [&](const Acc* partial) {
+            for (int i = 0; i < height; ++i) {
+                Acc* c = panelC + static_cast<size_t>(i) * strideC;
+                const Acc* p = partial + static_cast<size_t>(i) * strideC;
+                for (int j = 0; j < cols; ++j) {
+                    c[j] += p[j];
+                }
+            }
+        };
+
+        for (int k = 0; k < inner; k += blockRows) {
+            const int depth = std::min(blockRows, inner - k);
+            const T* blockB = B + static_cast<size_t>(k) * strideB;
+            if (k + depth < inner) {
+                const size_t nextRows = std::min(blockRows, inner - k - depth);
+                adviseRange(blockB + static_cast<size_t>(depth) * strideB, blockRowBytes * nextRows, MADV_WILLNEED);
+            }
+
+            if (!useOpenCL) {
+                // The new file is zero, so every block can add into C
+                gemmCPUAccumulate(height, depth, cols, panelA + k, strideA, blockB, strideB, panelC, strideC);
+                continue;
+            }
+
+            if (static_cast<int>(pending.size()) == slots) {
+                clWaitForEvents(1, &pending.front().done);
+                clReleaseEvent(pending.front().done);
+                accumulate(partials[pending.front().slot].data());
+                pending.pop_front();
+            }
+            cl_event done = AsyncGemm::instance().submit<T, Acc>(height, depth, cols, panelA + k, strideA, blockB,
+                                                                 strideB, partials[slot].data(), strideC);
+            if (done == nullptr) {
+                for (Pending& job : pending) {
+                    clWaitForEvents(1, &job.done);
+                    clReleaseEvent(job.done);
+                }
+                return false;
+            }
+            AsyncGemm::instance().flush();
+            pending.push_back({done, slot});
+            slot = (slot + 1) % slots;
+        }
+
+        for (Pending& job : pending) {
+            clWaitForEvents(1, &job.done);
+            clReleaseEvent(job.done);
+            accumulate(partials[job.slot].data());
+        }
+
+        // Start writing the finished rows of C back and drop the A panel so
+        // neither competes with the next panel for memory
+        std::pair<void*, size_t> written = pageRange(panelC, sizeof(Acc) * static_cast<size_t>(height) * strideC);
+        msync(written.first, written.second, MS_ASYNC);
+        adviseRange(panelA, sizeof(T) * static_cast<size_t>(height) * strideA, MADV_DONTNEED);
+    }
+
+    if (msync(fileC.address, fileC.length, MS_SYNC) != 0) {
+        std::cerr << "Error: Cannot write " << pathC << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template <typename T>
+void writeText(const Matrix<T>& matrix, std::ostream& out) {
+    // Each element is formatted with to_chars into one buffer that is
+    // written in large pieces, instead of a stream insertion per element
+    std::string buffer;
+    buffer.reserve(1 << 16);
+    char number[64];
+    for (int i = 0; i < matrix.getRows(); ++i) {
+        const T* row = matrix.row(i);
+        for (int j = 0; j < matrix.getCols(); ++j) {
+            std::to_chars_result converted;
+            if constexpr (std::is_floating_point<T>::value) {
+                // %g with six digits, which is what operator<< prints
+                converted = std::to_chars(number, number + sizeof(number), row[j], std::chars_format::general, 6);
+            } else {
+                converted = std::to_chars(number, number + sizeof(number), static_cast<int64_t>(row[j]));
+            }
+            buffer.append(number, converted.ptr);
+            buffer.push_back(' ');
+        }
+        buffer.push_back('\n');
+        if (buffer.size() >= (1 << 16) - 128) {
+            out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+template bool saveMatrix<float>(const Matrix<float>&, const std::string&);
+template bool saveMatrix<double>(const Matrix<double>&, const std::string&);
+template bool saveMatrix<int32_t>(const Matrix<int32_t>&, const std::string&);
+template bool saveMatrix<int64_t>(const Matrix<int64_t>&, const std::string&);
+template bool saveMatrix<int8_t>(const Matrix<int8_t>&, const std::string&);
+
+template Matrix<float> loadMatrix<float>(const std::string&);
+template Matrix<double> loadMatrix<double>(const std::string&);
+template Matrix<int32_t> loadMatrix<int32_t>(const std::string&);
+template Matrix<int64_t> loadMatrix<int64_t>(const std::string&);
+template Matrix<int8_t> loadMatrix<int8_t>(const std::string&);
+
+template bool multiplyFiles<float>(const std::string&, const std::string&, const std::string&, bool, size_t);
+template bool multiplyFiles<double>(const std::string&, const std::string&, const std::string&, bool, size_t);
+template bool multiplyFiles<int32_t>(const std::string&, const std::string&, const std::string&, bool, size_t);
+template bool multiplyFiles<int64_t>(const std::string&, const std::string&, const std::string&, bool, size_t);
+template bool multiplyFiles<int8_t>(const std::string&, const std::string&, const std::string&, bool, size_t);
+
+template void writeText<float>(const Matrix<float>&, std::ostream&);
+template void writeText<double>(const Matrix<double>&, std::ostream&);
+template void writeText<int32_t>(const Matrix<int32_t>&, std::ostream&);
+template void writeText<int64_t>(const Matrix<int64_t>&, std::ostream&);
+template void writeText<int8_t>(const Matrix<int8_t>&, std::ostream&);
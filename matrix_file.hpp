@@ -0,0 +1,57 @@
+// matrix_file.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef MATRIX_FILE_HPP
+#define MATRIX_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "matrix.hpp"
+
+// Binary matrix file: this header, then the rows starting at dataOffset
+// (one page in), each padded to the same stride Matrix uses. A mapped file
+// therefore has exactly the layout of Matrix storage and loads without a
+// copy.
+struct MatrixFileHeader {
+    char magic[8];          // "PHY250M" and a zero byte
+    uint32_t version;
+    uint32_t elementType;   // see matrix_file.cpp
+    int64_t rows;
+    int64_t cols;
+    int64_t stride;         // in elements
+    uint64_t dataOffset;    // in bytes from the start of the file
+    uint8_t reserved[16];
+};
+
+// Writes a matrix to path. Returns false and prints an error on failure.
+template <typename T>
+bool saveMatrix(const Matrix<T>& matrix, const std::string& path);
+
+// Maps path copy-on-write and returns a matrix backed by the mapping; the
+// pages are read as they are touched and the file itself never changes.
+// Returns an empty matrix if the file is missing, malformed or holds
+// another element type.
+template <typename T>
+Matrix<T> loadMatrix(const std::string& path);
+
+// Multiplies the matrices in pathA and pathB into a new file at pathC
+// without loading them whole, so they may be larger than memory. Row panels
+// of A are multiplied by blocks of rows of B, streamed in file order, and
+// summed into the mapped panel of C. memoryBytes bounds the panels and
+// blocks held at once; 0 uses a quarter of physical memory. int8_t inputs
+// produce an int32_t file. pathC may not name either input.
+template <typename T>
+bool multiplyFiles(const std::string& pathA, const std::string& pathB, const std::string& pathC,
+                   bool useOpenCL = false, size_t memoryBytes = 0);
+
+// Writes the matrix as text, one row per line, formatted like operator<<
+// but converted in bulk.
+template <typename T>
+void writeText(const Matrix<T>& matrix, std::ostream& out);
+
+#endif // MATRIX_FILE_HPP
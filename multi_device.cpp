@@ -0,0 +1,325 @@
+// multi_device.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "multi_device.hpp"
+#include "buffer_pool.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_async.hpp"
+#include "opencl_gemm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Rows below which a multiply is not worth splitting between devices
+const int minimumSplitRows = 64;
+
+template <typename T, typename Acc>
+double flopCount(const GemmJob<T, Acc>& job) {
+    return 2.0 * job.rows * job.inner * job.cols;
+}
+
+// The rows [begin, end) of job
+template <typename T, typename Acc>
+GemmJob<T, Acc> rowSlice(const GemmJob<T, Acc>& job, int begin, int end) {
+    GemmJob<T, Acc> slice = job;
+    slice.rows = end - begin;
+    slice.A = job.A + static_cast<size_t>(begin) * job.strideA;
+    slice.C = job.C + static_cast<size_t>(begin) * job.strideC;
+    return slice;
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Runs job on one device and waits for C. Returns false if anything fails
+// to enqueue; C is then incomplete. If given, elapsed gets the time from
+// the first write to the end of the read-back, leaving out tuning, kernel
+// builds and buffer allocation.
+template <typename T, typename Acc>
+bool runOnDevice(OpenCLRuntime& runtime, const GemmJob<T, Acc>& job, double* elapsed = nullptr) {
+    PHY250_TIME_SCOPE("deviceGemm");
+    cl_command_queue queue = runtime.getQueue();
+    BufferPool& pool = runtime.getBufferPool();
+    GemmConfig config = GemmAutotuner::instance(runtime).getConfig<T, Acc>(job.rows, job.inner, job.cols);
+    buildGemmKernel<T, Acc>(config, runtime);
+
+    cl_int error;
+    cl_mem bufferA = pool.acquire(sizeof(T) * static_cast<size_t>(job.rows) * job.strideA);
+    cl_mem bufferB = pool.acquire(sizeof(T) * static_cast<size_t>(job.inner) * job.strideB);
+    cl_mem bufferC = pool.acquire(sizeof(Acc) * static_cast<size_t>(job.rows) * job.strideC);
+
+    auto start = std::chrono::steady_clock::now();
+
+    error = bufferA && bufferB && bufferC ? CL_SUCCESS : CL_MEM_OBJECT_ALLOCATION_FAILURE;
+    if (error == CL_SUCCESS) {
+        error = enqueueWriteBlock(queue, bufferA, job.rows, job.inner, sizeof(T), job.strideA, job.A, runtime);
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueWriteBlock(queue, bufferB, job.inner, job.cols, sizeof(T), job.strideB, job.B, runtime);
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueGemm<T, Acc>(config, bufferA, bufferB, bufferC, job.rows, job.inner, job.cols,
+                                    job.strideA, job.strideB, job.strideC, queue, &runtime);
+        if (error != CL_SUCCESS && config.isTiled()) {
+            error = enqueueGemm<T, Acc>(GemmConfig(), bufferA, bufferB, bufferC, job.rows, job.inner, job.cols,
+                                        job.strideA, job.strideB, job.strideC, queue, &runtime);
+        }
+    }
+    if (error == CL_SUCCESS) {
+        size_t origin[3] = {0, 0, 0};
+        size_t region[3] = {sizeof(Acc) * job.cols, static_cast<size_t>(job.rows), 1};
+        size_t pitch = sizeof(Acc) * job.strideC;
+        PHY250_COUNT(BytesRead, region[0] * job.rows);
+        error = clEnqueueReadBufferRect(queue, bufferC, CL_TRUE, origin, origin, region, pitch, 0, pitch, 0,
+                                        job.C, 0, nullptr, runtime.profileEvent(OpenCLRuntime::ProfileRead));
+    }
+    if (error != CL_SUCCESS) {
+        clFinish(queue);
+    }
+    if (elapsed != nullptr) {
+        *elapsed = seconds(start);
+    }
+
+    pool.release(bufferA);
+    pool.release(bufferB);
+    pool.release(bufferC);
+    return error == CL_SUCCESS;
+}
+
+} // namespace
+
+DeviceGroup& DeviceGroup::instance() {
+    static DeviceGroup group;
+    return group;
+}
+
+DeviceGroup::DeviceGroup() {
+    OpenCLRuntime& first = OpenCLRuntime::instance();
+    if (!first.isAvailable()) {
+        return;
+    }
+    runtimes.push_back(&first);
+
+    const char* selector = std::getenv("PHY250_CL_DEVICES");
+    std::vector<OpenCLDeviceInfo> selected = OpenCLRuntime::selectDevices(selector != nullptr ? selector : "");
+    for (size_t i = 1; i < selected.size(); ++i) {
+        OpenCLRuntime* runtime = new OpenCLRuntime(selected[i]);
+        if (runtime->isAvailable()) {
+            runtimes.push_back(runtime);
+        } else {
+            std::cerr << "Warning: Skipping OpenCL device " << selected[i].name << std::endl;
+            delete runtime;
+        }
+    }
+}
+
+DeviceGroup::~DeviceGroup() {
+    // runtimes[0] is the shared instance
+    for (size_t i = 1; i < runtimes.size(); ++i) {
+        delete runtimes[i];
+    }
+}
+
+int DeviceGroup::getDeviceCount() const {
+    return static_cast<int>(runtimes.size());
+}
+
+OpenCLRuntime& DeviceGroup::getRuntime(int index) {
+    return *runtimes[index];
+}
+
+template <typename T, typename Acc>
+std::vector<int> DeviceGroup::usableDevices() const {
+    std::vector<int> devices;
+    for (int i = 0; i < getDeviceCount(); ++i) {
+        if (OpenCLElement<T>::isSupported(*runtimes[i]) && OpenCLElement<Acc>::isSupported(*runtimes[i])) {
+            devices.push_back(i);
+        }
+    }
+    return devices;
+}
+
+std::vector<double> DeviceGroup::throughputs(const std::vector<int>& devices, const std::string& type) {
+    std::lock_guard<std::mutex> guard(throughputMutex);
+    bool allMeasured = true;
+    for (int device : devices) {
+        allMeasured = allMeasured && measured.count(std::make_pair(device, type)) > 0;
+    }
+
+    std::vector<double> result;
+    for (int device : devices) {
+        if (allMeasured) {
+            result.push_back(measured[std::make_pair(device, type)]);
+            continue;
+        }
+        // Rough guess: GPU compute units do several times the work of CPU
+        // cores at the same clock
+        cl_device_id id = runtimes[device]->getDevice();
+        cl_uint units = 1, clock = 1;
+        cl_device_type kind = 0;
+        clGetDeviceInfo(id, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(units), &units, nullptr);
+        clGetDeviceInfo(id, CL_DEVICE_MAX_CLOCK_FREQUENCY, sizeof(clock), &clock, nullptr);
+        clGetDeviceInfo(id, CL_DEVICE_TYPE, sizeof(kind), &kind, nullptr);
+        double estimate = static_cast<double>(std::max(units, 1u)) * std::max(clock, 1u) * 1e6;
+        result.push_back(kind & CL_DEVICE_TYPE_GPU ? 8 * estimate : estimate);
+    }
+    return result;
+}
+
+void DeviceGroup::recordThroughput(int device, const std::string& type, double flops, double seconds) {
+    if (seconds <= 0) {
+        return;
+    }
+    std::lock_guard<std::mutex> guard(throughputMutex);
+    auto key = std::make_pair(device, type);
+    // The first run still pays for first-touch costs in the driver, such
+    // as mapping new buffers, so it is not a fair sample
+    if (warmedUp.insert(key).second) {
+        return;
+    }
+    double rate = flops / seconds;
+    auto found = measured.find(key);
+    // Average with earlier runs so one noisy run does not swing the split
+    measured[key] = found == measured.end() ? rate : 0.5 * (found->second + rate);
+}
+
+template <typename T, typename Acc>
+void DeviceGroup::gemm(const GemmJob<T, Acc>& job) {
+    std::vector<int> devices = usableDevices<T, Acc>();
+    if (devices.empty() || job.inner == 0 || job.cols == 0 || job.rows < minimumSplitRows) {
+        if (!devices.empty() && job.rows > 0 && job.inner > 0 && job.cols > 0 &&
+            runOnDevice(*runtimes[devices[0]], job)) {
+            return;
+        }
+        gemmCPU(job.rows, job.inner, job.cols, job.A, job.strideA, job.B, job.strideB, job.C, job.strideC);
+        return;
+    }
+
+    const std::string type = OpenCLElement<T>::name();
+    std::vector<double> rates = throughputs(devices, type);
+    double total = 0;
+    for (double rate : rates) {
+        total += rate;
+    }
+
+    // Each device's rows end where its share of the cumulative throughput
+    // does, so rounding never loses or repeats a row
+    std::vector<std::thread> threads;
+    double cumulative = 0;
+    int begin = 0;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        cumulative += rates[i];
+        int end = i + 1 == devices.size() ? job.rows : static_cast<int>(job.rows * (cumulative / total) + 0.5);
+        if (end <= begin) {
+            continue;
+        }
+        GemmJob<T, Acc> part = rowSlice(job, begin, end);
+        int device = devices[i];
+        threads.emplace_back([this, part, device, type]() {
+            double elapsed = 0;
+            if (runOnDevice(*runtimes[device], part, &elapsed)) {
+                recordThroughput(device, type, flopCount(part), elapsed);
+            } else {
+                std::cerr << "ERROR Enqueueing multiply on device " << device << "; computing its rows on the CPU"
+                          << std::endl;
+                gemmCPU(part.rows, part.inner, part.cols, part.A, part.strideA, part.B, part.strideB,
+                        part.C, part.strideC);
+            }
+        });
+        begin = end;
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+template <typename T, typename Acc>
+void DeviceGroup::gemmBatch(const std::vector<GemmJob<T, Acc>>& jobs) {
+    std::vector<int> devices = usableDevices<T, Acc>();
+    if (devices.empty()) {
+        for (const GemmJob<T, Acc>& job : jobs) {
+            gemmCPU(job.rows, job.inner, job.cols, job.A, job.strideA, job.B, job.strideB, job.C, job.strideC);
+        }
+        return;
+    }
+
+    const std::string type = OpenCLElement<T>::name();
+    std::vector<double> rates = throughputs(devices, type);
+
+    std::vector<size_t> order(jobs.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return flopCount(jobs[a]) > flopCount(jobs[b]);
+    });
+
+    // Expected busy time of each device as jobs are handed out
+    std::vector<double> busy(devices.size(), 0.0);
+    std::vector<std::vector<size_t>> assigned(devices.size());
+    for (size_t index : order) {
+        size_t best = 0;
+        for (size_t i = 1; i < devices.size(); ++i) {
+            if (busy[i] + flopCount(jobs[index]) / rates[i] < busy[best] + flopCount(jobs[index]) / rates[best]) {
+                best = i;
+            }
+        }
+        busy[best] += flopCount(jobs[index]) / rates[best];
+        assigned[best].push_back(index);
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (assigned[i].empty()) {
+            continue;
+        }
+        int device = devices[i];
+        const std::vector<size_t>& mine = assigned[i];
+        threads.emplace_back([this, &jobs, &mine, device, type]() {
+            bool working = true;
+            for (size_t index : mine) {
+                const GemmJob<T, Acc>& job = jobs[index];
+                if (job.rows == 0 || job.cols == 0) {
+                    continue;
+                }
+                double elapsed = 0;
+                if (working && job.inner > 0 && runOnDevice(*runtimes[device], job, &elapsed)) {
+                    recordThroughput(device, type, flopCount(job), elapsed);
+                    continue;
+                }
+                if (working && job.inner > 0) {
+                    std::cerr << "ERROR Enqueueing batch multiply; finishing this device's jobs on the CPU"
+                              << std::endl;
+                    working = false;
+                }
+                gemmCPU(job.rows, job.inner, job.cols, job.A, job.strideA, job.B, job.strideB, job.C, job.strideC);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+template void DeviceGroup::gemm<float, float>(const GemmJob<float, float>&);
+template void DeviceGroup::gemm<double, double>(const GemmJob<double, double>&);
+template void DeviceGroup::gemm<int32_t, int32_t>(const GemmJob<int32_t, int32_t>&);
+template void DeviceGroup::gemm<int64_t, int64_t>(const GemmJob<int64_t, int64_t>&);
+template void DeviceGroup::gemm<int8_t, int32_t>(const GemmJob<int8_t, int32_t>&);
+
+template void DeviceGroup::gemmBatch<float, float>(const std::vector<GemmJob<float, float>>&);
+template void DeviceGroup::gemmBatch<double, double>(const std::vector<GemmJob<double, double>>&);
+template void DeviceGroup::gemmBatch<int32_t, int32_t>(const std::vector<GemmJob<int32_t, int32_t>>&);
+template void DeviceGroup::gemmBatch<int64_t, int64_t>(const std::vector<GemmJob<int64_t, int64_t>>&);
+template void DeviceGroup::gemmBatch<int8_t, int32_t>(const std::vector<GemmJob<int8_t, int32_t>>&);
@@ -0,0 +1,81 @@
+// multi_device.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef MULTI_DEVICE_HPP
+#define MULTI_DEVICE_HPP
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "opencl_runtime.hpp"
+
+// One C = A * B with the same layout as gemmCPU: A is rows x inner, B is
+// inner x cols and C is rows x cols, row-major with the given row strides
+template <typename T, typename Acc>
+struct GemmJob {
+    int rows;
+    int inner;
+    int cols;
+    const T* A;
+    int strideA;
+    const T* B;
+    int strideB;
+    Acc* C;
+    int strideC;
+};
+
+// Every OpenCL device selected by PHY250_CL_DEVICES (all of them by
+// default), each with its own runtime: context, queues, program cache and
+// GEMM tuner. Device 0 is OpenCLRuntime::instance().
+//
+// Work is shared out in proportion to each device's throughput for the
+// element type, so the devices finish together. Throughput is measured on
+// every run but the first for each device and type, from the first upload
+// to the end of the read-back. Until all the devices involved have been
+// measured, it is estimated from compute units and clock rate. Work a
+// device cannot run, because it lacks the element type or an enqueue
+// fails, is done with gemmCPU instead.
+class DeviceGroup {
+public:
+    static DeviceGroup& instance();
+
+    int getDeviceCount() const;
+    OpenCLRuntime& getRuntime(int index);
+
+    // Splits the rows of one multiply between the devices and runs the
+    // parts at the same time
+    template <typename T, typename Acc>
+    void gemm(const GemmJob<T, Acc>& job);
+
+    // Runs each job whole on one device. Jobs are placed largest first on
+    // the device expected to finish them soonest.
+    template <typename T, typename Acc>
+    void gemmBatch(const std::vector<GemmJob<T, Acc>>& jobs);
+
+private:
+    DeviceGroup();
+    ~DeviceGroup();
+
+    DeviceGroup(const DeviceGroup&) = delete;
+    DeviceGroup& operator=(const DeviceGroup&) = delete;
+
+    // Devices able to run T into Acc, and their throughputs in flop/s
+    template <typename T, typename Acc>
+    std::vector<int> usableDevices() const;
+    std::vector<double> throughputs(const std::vector<int>& devices, const std::string& type);
+    void recordThroughput(int device, const std::string& type, double flops, double seconds);
+
+    std::vector<OpenCLRuntime*> runtimes;
+    std::mutex throughputMutex;
+    std::map<std::pair<int, std::string>, double> measured;
+    // Device and type pairs whose first, discarded, run is done
+    std::set<std::pair<int, std::string>> warmedUp;
+};
+
+#endif // MULTI_DEVICE_HPP
@@ -0,0 +1,137 @@
+// opencl_async.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "opencl_async.hpp"
+#include "instrumentation.hpp"
+#include "opencl_gemm.hpp"
+
+#include <cstdint>
+#include <iostream>
+
+cl_int enqueueWriteBlock(cl_command_queue queue, cl_mem buffer, int rows, int cols, size_t elementSize,
+                         int stride, const void* host, OpenCLRuntime& runtime) {
+    size_t origin[3] = {0, 0, 0};
+    size_t region[3] = {elementSize * cols, static_cast<size_t>(rows), 1};
+    size_t pitch = elementSize * stride;
+    PHY250_COUNT(BytesWritten, region[0] * rows);
+    return clEnqueueWriteBufferRect(queue, buffer, CL_FALSE, origin, origin, region, pitch, 0, pitch, 0, host,
+                                    0, nullptr, runtime.profileEvent(OpenCLRuntime::ProfileWrite));
+}
+
+AsyncGemm& AsyncGemm::instance() {
+    static AsyncGemm async;
+    return async;
+}
+
+AsyncGemm::AsyncGemm() : nextQueue(0) {
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    int queues = runtime.isAvailable() ? runtime.getQueueCount() : 0;
+    staging.resize(queues);
+    for (Staging& buffers : staging) {
+        for (int slot = 0; slot < 3; ++slot) {
+            buffers.buffers[slot] = nullptr;
+            buffers.sizes[slot] = 0;
+        }
+    }
+}
+
+AsyncGemm::~AsyncGemm() {
+    for (Staging& buffers : staging) {
+        for (cl_mem buffer : buffers.buffers) {
+            if (buffer) clReleaseMemObject(buffer);
+        }
+    }
+}
+
+cl_mem AsyncGemm::reserve(Staging& buffers, int slot, size_t bytes) {
+    if (buffers.sizes[slot] >= bytes) {
+        return buffers.buffers[slot];
+    }
+
+    // Jobs already queued on the old buffer keep it alive until they finish,
+    // so it can be released straight away.
+    if (buffers.buffers[slot]) {
+        clReleaseMemObject(buffers.buffers[slot]);
+    }
+    cl_int error;
+    buffers.buffers[slot] = clCreateBuffer(OpenCLRuntime::instance().getContext(), CL_MEM_READ_WRITE, bytes, nullptr, &error);
+    buffers.sizes[slot] = buffers.buffers[slot] ? bytes : 0;
+    if (buffers.buffers[slot] == nullptr) {
+        std::cerr << "ERROR Creating buffers" << std::endl;
+    }
+    return buffers.buffers[slot];
+}
+
+template <typename T, typename Acc>
+cl_event AsyncGemm::submit(int rows, int inner, int cols,
+                           const T* A, int strideA,
+                           const T* B, int strideB,
+                           Acc* C, int strideC) {
+    if (staging.empty() || rows <= 0 || inner <= 0 || cols <= 0) {
+        return nullptr;
+    }
+    GemmConfig config = GemmAutotuner::instance().getConfig<T, Acc>(rows, inner, cols);
+
+    std::lock_guard<std::mutex> guard(asyncMutex);
+    int index = nextQueue;
+    nextQueue = (nextQueue + 1) % static_cast<int>(staging.size());
+    cl_command_queue queue = OpenCLRuntime::instance().getQueue(index);
+
+    size_t bytesA = sizeof(T) * static_cast<size_t>(rows) * strideA;
+    size_t bytesB = sizeof(T) * static_cast<size_t>(inner) * strideB;
+    size_t bytesC = sizeof(Acc) * static_cast<size_t>(rows) * strideC;
+    cl_mem bufferA = reserve(staging[index], 0, bytesA);
+    cl_mem bufferB = reserve(staging[index], 1, bytesB);
+    cl_mem bufferC = reserve(staging[index], 2, bytesC);
+    if (bufferA == nullptr || bufferB == nullptr || bufferC == nullptr) {
+        return nullptr;
+    }
+
+    // The queue is in order, so this job's uploads wait for the previous
+    // job on the same staging buffers without any host synchronization.
+    cl_int error = enqueueWriteBlock(queue, bufferA, rows, inner, sizeof(T), strideA, A);
+    if (error == CL_SUCCESS) {
+        error = enqueueWriteBlock(queue, bufferB, inner, cols, sizeof(T), strideB, B);
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueGemm<T, Acc>(config, bufferA, bufferB, bufferC, rows, inner, cols, strideA, strideB, strideC, queue);
+        if (error != CL_SUCCESS && config.isTiled()) {
+            error = enqueueGemm<T, Acc>(GemmConfig(), bufferA, bufferB, bufferC, rows, inner, cols, strideA, strideB, strideC, queue);
+        }
+    }
+
+    // Only the rows x cols block is read back, so the row padding of C keeps
+    // its zeros whatever earlier jobs left in the staging buffer.
+    cl_event done = nullptr;
+    if (error == CL_SUCCESS) {
+        size_t origin[3] = {0, 0, 0};
+        size_t region[3] = {sizeof(Acc) * cols, static_cast<size_t>(rows), 1};
+        size_t pitch = sizeof(Acc) * strideC;
+        PHY250_COUNT(BytesRead, region[0] * rows);
+        error = clEnqueueReadBufferRect(queue, bufferC, CL_FALSE, origin, origin, region, pitch, 0, pitch, 0, C,
+                                        0, nullptr, &done);
+        OpenCLRuntime::instance().recordEvent(OpenCLRuntime::ProfileRead, done);
+    }
+    if (error != CL_SUCCESS) {
+        std::cerr << "ERROR Enqueueing asynchronous multiply" << std::endl;
+        // Nothing may still be reading A and B or writing C once we return
+        clFinish(queue);
+        return nullptr;
+    }
+    return done;
+}
+
+void AsyncGemm::flush() {
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    for (int i = 0; i < static_cast<int>(staging.size()); ++i) {
+        clFlush(runtime.getQueue(i));
+    }
+}
+
+template cl_event AsyncGemm::submit<float, float>(int, int, int, const float*, int, const float*, int, float*, int);
+template cl_event AsyncGemm::submit<double, double>(int, int, int, const double*, int, const double*, int, double*, int);
+template cl_event AsyncGemm::submit<int32_t, int32_t>(int, int, int, const int32_t*, int, const int32_t*, int, int32_t*, int);
+template cl_event AsyncGemm::submit<int64_t, int64_t>(int, int, int, const int64_t*, int, const int64_t*, int, int64_t*, int);
+template cl_event AsyncGemm::submit<int8_t, int32_t>(int, int, int, const int8_t*, int, const int8_t*, int, int32_t*, int);
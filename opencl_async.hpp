@@ -0,0 +1,64 @@
+// opencl_async.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef OPENCL_ASYNC_HPP
+#define OPENCL_ASYNC_HPP
+
+#include <mutex>
+#include <vector>
+
+#include "opencl_runtime.hpp"
+
+// Copies the rows x cols block at host into buffer, keeping the row pitch.
+// Only the block itself is read, so host may point into a larger matrix.
+// queue belongs to runtime, which defaults to the shared one.
+cl_int enqueueWriteBlock(cl_command_queue queue, cl_mem buffer, int rows, int cols, size_t elementSize,
+                         int stride, const void* host, OpenCLRuntime& runtime = OpenCLRuntime::instance());
+
+// Runs independent multiplies from host memory on the runtime queues in
+// turn. Each queue owns device staging buffers for A, B and C that every job
+// on it reuses, so consecutive jobs are double buffered across queues: while
+// one queue runs a kernel the next is already uploading its operands, and no
+// job allocates device memory once the buffers have grown to size.
+class AsyncGemm {
+public:
+    static AsyncGemm& instance();
+
+    // Enqueues the uploads of A and B, C = A * B and the readback of C on
+    // the next queue, without waiting or flushing. Only the rows x inner,
+    // inner x cols and rows x cols blocks are transferred, so the pointers
+    // may be views into larger matrices. Returns an event that
+    // completes once C is in host memory, or nullptr on failure. A and B must
+    // not change, and C must not be touched, until the event completes.
+    template <typename T, typename Acc>
+    cl_event submit(int rows, int inner, int cols,
+                    const T* A, int strideA,
+                    const T* B, int strideB,
+                    Acc* C, int strideC);
+
+    // Starts everything submitted so far
+    void flush();
+
+private:
+    AsyncGemm();
+    ~AsyncGemm();
+
+    AsyncGemm(const AsyncGemm&) = delete;
+    AsyncGemm& operator=(const AsyncGemm&) = delete;
+
+    struct Staging {
+        cl_mem buffers[3];
+        size_t sizes[3];
+    };
+
+    // Returns staging buffer slot of at least bytes, growing it if needed
+    cl_mem reserve(Staging& staging, int slot, size_t bytes);
+
+    std::mutex asyncMutex;
+    std::vector<Staging> staging;
+    int nextQueue;
+};
+
+#endif // OPENCL_ASYNC_HPP
@@ -0,0 +1,614 @@
+// opencl_gemm.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "opencl_gemm.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Kernel body shared by every element type. TYPE is the operand type and ACC
+// the accumulator/result type; gemmSource defines both in front of it.
+// Fused variants also define TRANS_A or TRANS_B for operands stored
+// transposed, and FUSED_ARGS and STORE for the epilogue.
+const char* gemmKernelBody = R"(
+#ifndef FUSED_ARGS
+    #define FUSED_ARGS
+    #define STORE(row, col, value) C[(row) * strideC + (col)] = (value)
+#endif
+
+#ifdef TRANS_A
+    #define A_AT(row, k) A[(k) * strideA + (row)]
+#else
+    #define A_AT(row, k) A[(row) * strideA + (k)]
+#endif
+#ifdef TRANS_B
+    #define B_AT(k, col) B[(col) * strideB + (k)]
+#else
+    #define B_AT(k, col) B[(k) * strideB + (col)]
+#endif
+
+    __kernel void matrixMul(__global const TYPE* A,
+                             __global const TYPE* B,
+                             __global ACC* C,
+                             const int rowsA,
+                             const int colsA,
+                             const int colsB,
+                             const int strideA,
+                             const int strideB,
+                             const int strideC FUSED_ARGS) {
+        int globalRow = get_global_id(0);
+        int globalCol = get_global_id(1);
+        ACC sum = 0;
+
+        for (int k = 0; k < colsA; ++k) {
+            sum += (ACC)A_AT(globalRow, k) * (ACC)B_AT(k, globalCol);
+        }
+
+        STORE(globalRow, globalCol, sum);
+    }
+
+#ifdef TS
+    #define RTSM (TS / WPTM)
+    #define RTSN (TS / WPTN)
+    #define THREADS (RTSM * RTSN)
+    #define CONCAT(a, b) a##b
+    #define VLOAD(n) CONCAT(vload, n)
+    #define VSTORE(n) CONCAT(vstore, n)
+
+    // Copies VW elements of row-major M starting at (row, col) into
+    // tile[r][c], zero-filling anything outside rows x cols.
+    #if VW == 1
+    #define LOAD_TILE(tile, M, row, col, rows, cols, stride, r, c) \
+        tile[r][c] = (row < rows && col < cols) ? M[row * stride + col] : 0;
+    #else
+    #define LOAD_TILE(tile, M, row, col, rows, cols, stride, r, c) \
+        if (row < rows && col + VW <= cols) { \
+            VSTORE(VW)(VLOAD(VW)(0, M + row * stride + col), 0, &tile[r][c]); \
+        } else { \
+            for (int e = 0; e < VW; ++e) { \
+                tile[r][c + e] = (row < rows && col + e < cols) ? M[row * stride + col + e] : 0; \
+            } \
+        }
+    #endif
+
+    __kernel void matrixMulTiled(__global const TYPE* A,
+                                 __global const TYPE* B,
+                                 __global ACC* C,
+                                 const int rowsA,
+                                 const int colsA,
+                                 const int colsB,
+                                 const int strideA,
+                                 const int strideB,
+                                 const int strideC FUSED_ARGS) {
+        __local TYPE tileA[TS][TS];
+        __local TYPE tileB[TS][TS];
+
+        const int localRow = get_local_id(0);
+        const int localCol = get_local_id(1);
+        const int rowBase = get_group_id(0) * TS;
+        const int colBase = get_group_id(1) * TS;
+        const int tid = localRow * RTSN + localCol;
+
+        ACC acc[WPTM][WPTN];
+        for (int wm = 0; wm < WPTM; ++wm) {
+            for (int wn = 0; wn < WPTN; ++wn) {
+                acc[wm][wn] = 0;
+            }
+        }
+
+        for (int kBase = 0; kBase < colsA; kBase += TS) {
+            for (int v = tid; v < TS * TS / VW; v += THREADS) {
+                const int r = v / (TS / VW);
+                const int c = (v % (TS / VW)) * VW;
+
+#ifndef TRANS_A
+                const int rowA = rowBase + r;
+                const int colA = kBase + c;
+                LOAD_TILE(tileA, A, rowA, colA, rowsA, colsA, strideA, r, c)
+#endif
+
+#ifndef TRANS_B
+                const int rowB = kBase + r;
+                const int colB = colBase + c;
+                LOAD_TILE(tileB, B, rowB, colB, colsA, colsB, strideB, r, c)
+#endif
+            }
+#if defined(TRANS_A) || defined(TRANS_B)
+            // Transposed operands are contiguous down the tile's columns, so
+            // neighbouring work items take neighbouring rows
+            for (int v = tid; v < TS * TS; v += THREADS) {
+                const int r = v % TS;
+                const int c = v / TS;
+#ifdef TRANS_A
+                tileA[r][c] = (rowBase + r < rowsA && kBase + c < colsA) ? A_AT(rowBase + r, kBase + c) : 0;
+#endif
+#ifdef TRANS_B
+                tileB[r][c] = (kBase + r < colsA && colBase + c < colsB) ? B_AT(kBase + r, colBase + c) : 0;
+#endif
+            }
+#endif
+            barrier(CLK_LOCAL_MEM_FENCE);
+
+            for (int k = 0; k < TS; ++k) {
+                ACC b[WPTN];
+                for (int wn = 0; wn < WPTN; ++wn) {
+                    b[wn] = tileB[k][localCol + wn * RTSN];
+                }
+                for (int wm = 0; wm < WPTM; ++wm) {
+                    const ACC a = tileA[localRow + wm * RTSM][k];
+                    for (int wn = 0; wn < WPTN; ++wn) {
+                        acc[wm][wn] += a * b[wn];
+                    }
+                }
+            }
+            barrier(CLK_LOCAL_MEM_FENCE);
+        }
+
+        for (int wm = 0; wm < WPTM; ++wm) {
+            const int row = rowBase + localRow + wm * RTSM;
+            for (int wn = 0; wn < WPTN; ++wn) {
+                const int col = colBase + localCol + wn * RTSN;
+                if (row < rowsA && col < colsB) {
+                    STORE(row, col, acc[wm][wn]);
+                }
+            }
+        }
+    }
+#endif
+)";
+
+// Kernel source specialised for one operand/accumulator pair. Each pair is
+// a distinct source string, so the runtime builds and caches it separately.
+template <typename T, typename Acc>
+const std::string& gemmSource() {
+    static const std::string source = openCLTypeDefines<T, Acc>() + gemmKernelBody;
+    return source;
+}
+
+// Source for a fused multiply: defines for the transposes and the epilogue
+// in front of the shared body. Each op takes two kernel arguments, so
+// changing an op's constants does not need a new program.
+template <typename T, typename Acc>
+std::string fusedGemmSource(bool transposeA, bool transposeB, const GemmEpilogue<Acc>& epilogue, bool hasAddend) {
+    std::ostringstream text;
+    text << openCLTypeDefines<T, Acc>();
+    if (transposeA) {
+        text << "#define TRANS_A\n";
+    }
+    if (transposeB) {
+        text << "#define TRANS_B\n";
+    }
+
+    text << "#define FUSED_ARGS , const ACC alpha";
+    if (hasAddend) {
+        text << ", __global const ACC* D, const int strideDRow, const int strideDCol, const ACC beta";
+    }
+    for (int op = 0; op < epilogue.opCount; ++op) {
+        text << ", const ACC p" << 2 * op << ", const ACC p" << 2 * op + 1;
+    }
+    text << "\n#define STORE(row, col, value) { ACC fused = alpha * (value);";
+    if (hasAddend) {
+        text << " fused += beta * D[(row) * strideDRow + (col) * strideDCol];";
+    }
+    for (int op = 0; op < epilogue.opCount; ++op) {
+        std::string first = "p" + std::to_string(2 * op);
+        std::string second = "p" + std::to_string(2 * op + 1);
+        switch (epilogue.ops[op].kind) {
+        case PostOp<Acc>::Relu: text << " fused = fused > (ACC)0 ? fused : (ACC)0;"; break;
+        case PostOp<Acc>::Clamp:
+            text << " fused = fused < " << first << " ? " << first << " : fused > " << second << " ? " << second << " : fused;";
+            break;
+        case PostOp<Acc>::Abs: text << " fused = fused < (ACC)0 ? -fused : fused;"; break;
+        case PostOp<Acc>::Add: text << " fused += " << first << ";"; break;
+        case PostOp<Acc>::Multiply: text << " fused *= " << first << ";"; break;
+        }
+    }
+    text << " C[(row) * strideC + (col)] = fused; }\n";
+    text << gemmKernelBody;
+    return text.str();
+}
+
+// Values the tuner multiplies: small integers, so every supported type
+// computes the reference product exactly and results can be compared as is.
+template <typename T>
+T randomElement(std::mt19937& generator) {
+    std::uniform_int_distribution<int> distribution(-8, 8);
+    return static_cast<T>(distribution(generator));
+}
+
+// Shapes below this many multiply-adds run the default config untuned; the
+// launch overhead dominates and benchmarking would cost more than it saves.
+const double minimumTunedWork = 64.0 * 64.0 * 64.0;
+
+// Benchmark problems are capped so tuning a huge bucket stays quick.
+const int maximumTunedDimension = 1024;
+
+int roundUpPowerOfTwo(int value) {
+    int result = 16;
+    while (result < value && result < (1 << 30)) {
+        result <<= 1;
+    }
+    return result;
+}
+
+size_t deviceSize(OpenCLRuntime& runtime, cl_device_info param) {
+    size_t value = 0;
+    clGetDeviceInfo(runtime.getDevice(), param, sizeof(value), &value, nullptr);
+    return value;
+}
+
+cl_ulong deviceLong(OpenCLRuntime& runtime, cl_device_info param) {
+    cl_ulong value = 0;
+    clGetDeviceInfo(runtime.getDevice(), param, sizeof(value), &value, nullptr);
+    return value;
+}
+
+} // namespace
+
+template <typename T, typename Acc>
+std::string openCLTypeDefines() {
+    std::ostringstream text;
+    if (std::is_same<T, double>::value) {
+        text << "#pragma OPENCL EXTENSION cl_khr_fp64 : enable\n";
+    }
+    text << "#define TYPE " << OpenCLElement<T>::name() << "\n"
+         << "#define ACC " << OpenCLElement<Acc>::name() << "\n";
+    return text.str();
+}
+
+GemmConfig::GemmConfig() : tile(0), rowsPerItem(1), colsPerItem(1), vectorWidth(1) {
+}
+
+GemmConfig::GemmConfig(int tile, int rowsPerItem, int colsPerItem, int vectorWidth)
+    : tile(tile), rowsPerItem(rowsPerItem), colsPerItem(colsPerItem), vectorWidth(vectorWidth) {
+}
+
+bool GemmConfig::isTiled() const {
+    return tile > 0;
+}
+
+std::string GemmConfig::kernelName() const {
+    return isTiled() ? "matrixMulTiled" : "matrixMul";
+}
+
+std::string GemmConfig::buildOptions() const {
+    if (!isTiled()) {
+        return "";
+    }
+    std::ostringstream options;
+    options << "-DTS=" << tile << " -DWPTM=" << rowsPerItem << " -DWPTN=" << colsPerItem << " -DVW=" << vectorWidth;
+    return options.str();
+}
+
+void GemmConfig::localSize(size_t local[2]) const {
+    local[0] = isTiled() ? tile / rowsPerItem : 1;
+    local[1] = isTiled() ? tile / colsPerItem : 1;
+}
+
+void GemmConfig::globalSize(int rows, int cols, size_t global[2]) const {
+    if (!isTiled()) {
+        global[0] = rows;
+        global[1] = cols;
+        return;
+    }
+    global[0] = static_cast<size_t>((rows + tile - 1) / tile) * (tile / rowsPerItem);
+    global[1] = static_cast<size_t>((cols + tile - 1) / tile) * (tile / colsPerItem);
+}
+
+template <typename T, typename Acc>
+cl_int enqueueGemm(const GemmConfig& config, cl_mem bufferA, cl_mem bufferB, cl_mem bufferC,
+                   int rows, int inner, int cols, int strideA, int strideB, int strideC,
+                   cl_command_queue queue, OpenCLRuntime* deviceRuntime) {
+    return enqueueGemmFused<T, Acc>(config, false, false, GemmEpilogue<Acc>(), bufferA, bufferB, bufferC, nullptr,
+                                    rows, inner, cols, strideA, strideB, strideC, queue, deviceRuntime);
+}
+
+template <typename T, typename Acc>
+bool buildGemmKernel(const GemmConfig& config, OpenCLRuntime& runtime) {
+    return runtime.getKernel(gemmSource<T, Acc>(), config.kernelName(), config.buildOptions()) != nullptr;
+}
+
+template <typename T, typename Acc>
+cl_int enqueueGemmFused(const GemmConfig& config, bool transposeA, bool transposeB, const GemmEpilogue<Acc>& epilogue,
+                        cl_mem bufferA, cl_mem bufferB, cl_mem bufferC, cl_mem bufferAddend,
+                        int rows, int inner, int cols, int strideA, int strideB, int strideC,
+                        cl_command_queue queue, OpenCLRuntime* deviceRuntime) {
+    OpenCLRuntime& runtime = deviceRuntime != nullptr ? *deviceRuntime : OpenCLRuntime::instance();
+    const bool hasAddend = bufferAddend != nullptr;
+    const bool fused = transposeA || transposeB || epilogue.alpha != Acc(1) || hasAddend || epilogue.opCount > 0;
+    cl_kernel kernel = fused ? runtime.getKernel(fusedGemmSource<T, Acc>(transposeA, transposeB, epilogue, hasAddend),
+                                                 config.kernelName(), config.buildOptions())
+                             : runtime.getKernel(gemmSource<T, Acc>(), config.kernelName(), config.buildOptions());
+    if (kernel == nullptr) {
+        return CL_BUILD_PROGRAM_FAILURE;
+    }
+
+    size_t globalWorkSize[2];
+    size_t localWorkSize[2];
+    config.globalSize(rows, cols, globalWorkSize);
+    config.localSize(localWorkSize);
+
+    std::lock_guard<std::mutex> guard(runtime.lock());
+    clSetKernelArg(kernel, 0, sizeof(cl_mem), &bufferA);
+    clSetKernelArg(kernel, 1, sizeof(cl_mem), &bufferB);
+    clSetKernelArg(kernel, 2, sizeof(cl_mem), &bufferC);
+    clSetKernelArg(kernel, 3, sizeof(int), &rows);
+    clSetKernelArg(kernel, 4, sizeof(int), &inner);
+    clSetKernelArg(kernel, 5, sizeof(int), &cols);
+    clSetKernelArg(kernel, 6, sizeof(int), &strideA);
+    clSetKernelArg(kernel, 7, sizeof(int), &strideB);
+    clSetKernelArg(kernel, 8, sizeof(int), &strideC);
+    if (fused) {
+        cl_uint index = 9;
+        clSetKernelArg(kernel, index++, sizeof(Acc), &epilogue.alpha);
+        if (hasAddend) {
+            clSetKernelArg(kernel, index++, sizeof(cl_mem), &bufferAddend);
+            clSetKernelArg(kernel, index++, sizeof(int), &epilogue.addendRowStride);
+            clSetKernelArg(kernel, index++, sizeof(int), &epilogue.addendColStride);
+            clSetKernelArg(kernel, index++, sizeof(Acc), &epilogue.beta);
+        }
+        for (int op = 0; op < epilogue.opCount; ++op) {
+            clSetKernelArg(kernel, index++, sizeof(Acc), &epilogue.ops[op].first);
+            clSetKernelArg(kernel, index++, sizeof(Acc), &epilogue.ops[op].second);
+        }
+    }
+
+    PHY250_COUNT(KernelLaunches, 1);
+    return clEnqueueNDRangeKernel(queue != nullptr ? queue : runtime.getQueue(), kernel, 2, nullptr, globalWorkSize,
+                                  config.isTiled() ? localWorkSize : nullptr, 0, nullptr,
+                                  runtime.profileEvent(OpenCLRuntime::ProfileKernel));
+}
+
+GemmAutotuner& GemmAutotuner::instance(OpenCLRuntime& runtime) {
+    // Tuners live as long as the process, like the runtimes they belong to
+    static std::mutex tunersMutex;
+    static std::map<OpenCLRuntime*, GemmAutotuner*> tuners;
+    std::lock_guard<std::mutex> guard(tunersMutex);
+    GemmAutotuner*& tuner = tuners[&runtime];
+    if (tuner == nullptr) {
+        tuner = new GemmAutotuner(runtime);
+    }
+    return *tuner;
+}
+
+GemmAutotuner::GemmAutotuner(OpenCLRuntime& runtime) : runtime(runtime), enabled(true) {
+    const char* setting = std::getenv("PHY250_AUTOTUNE");
+    if (setting != nullptr && std::string(setting) == "0") {
+        enabled = false;
+    }
+    tuningFile = runtime.getCacheFile("gemm-tuning.txt");
+    load();
+}
+
+template <typename T>
+GemmAutotuner::Bucket GemmAutotuner::bucketFor(int rows, int inner, int cols) {
+    return Bucket(OpenCLElement<T>::name(), roundUpPowerOfTwo(rows), roundUpPowerOfTwo(inner), roundUpPowerOfTwo(cols));
+}
+
+GemmConfig GemmAutotuner::defaultConfig(size_t elementSize) const {
+    GemmConfig config(16, 2, 2, 4);
+    if (fitsDevice(config, elementSize)) {
+        return config;
+    }
+    config = GemmConfig(8, 1, 1, 1);
+    if (fitsDevice(config, elementSize)) {
+        return config;
+    }
+    return GemmConfig();
+}
+
+bool GemmAutotuner::fitsDevice(const GemmConfig& config, size_t elementSize) const {
+    if (!config.isTiled()) {
+        return true;
+    }
+    size_t local[2];
+    config.localSize(local);
+    size_t threads = local[0] * local[1];
+    size_t localBytes = 2 * elementSize * config.tile * config.tile;
+    return threads <= deviceSize(runtime, CL_DEVICE_MAX_WORK_GROUP_SIZE) &&
+           localBytes <= deviceLong(runtime, CL_DEVICE_LOCAL_MEM_SIZE);
+}
+
+template <typename T, typename Acc>
+GemmConfig GemmAutotuner::getConfig(int rows, int inner, int cols) {
+    if (static_cast<double>(rows) * inner * cols < minimumTunedWork || !enabled) {
+        return defaultConfig(sizeof(T));
+    }
+
+    Bucket bucket = bucketFor<T>(rows, inner, cols);
+    {
+        std::lock_guard<std::mutex> guard(tunerMutex);
+        auto found = configs.find(bucket);
+        if (found != configs.end()) {
+            return found->second;
+        }
+    }
+    return tune<T, Acc>(rows, inner, cols);
+}
+
+template <typename T, typename Acc>
+double GemmAutotuner::benchmark(const GemmConfig& config, int rows, int inner, int cols,
+                                cl_mem bufferA, cl_mem bufferB, cl_mem bufferC, const std::vector<Acc>& expected) {
+    cl_command_queue queue = runtime.getQueue();
+    double best = std::numeric_limits<double>::infinity();
+    std::vector<Acc> result(expected.size());
+    // One untimed run warms up the kernel and checks it, so a config
+    // that miscompiles on this device can never win.
+    cl_int error = enqueueGemm<T, Acc>(config, bufferA, bufferB, bufferC, rows, inner, cols, inner, cols, cols, queue, &runtime);
+    if (error == CL_SUCCESS) {
+        error = clEnqueueReadBuffer(queue, bufferC, CL_TRUE, 0, sizeof(Acc) * result.size(), result.data(), 0, nullptr, nullptr);
+    }
+    if (error == CL_SUCCESS && result == expected) {
+        for (int repeat = 0; repeat < 3 && error == CL_SUCCESS; ++repeat) {
+            auto start = std::chrono::steady_clock::now();
+            error = enqueueGemm<T, Acc>(config, bufferA, bufferB, bufferC, rows, inner, cols, inner, cols, cols, queue, &runtime);
+            clFinish(queue);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (error == CL_SUCCESS) {
+                best = std::min(best, elapsed.count());
+            }
+        }
+    }
+    return best;
+}
+
+template <typename T, typename Acc>
+GemmConfig GemmAutotuner::tune(int rows, int inner, int cols) {
+    if (!runtime.isAvailable() || !OpenCLElement<T>::isSupported(runtime)) {
+        return GemmConfig();
+    }
+
+    PHY250_TIME_SCOPE("autotune");
+    Bucket bucket = bucketFor<T>(rows, inner, cols);
+    std::lock_guard<std::mutex> guard(tunerMutex);
+    auto found = configs.find(bucket);
+    if (found != configs.end()) {
+        return found->second;
+    }
+
+    // One problem and reference product serve every candidate. The small
+    // integer operands keep every product exact, so the blocked CPU GEMM
+    // gives the same answer as the naive kernel in any type.
+    rows = std::min(std::get<1>(bucket), maximumTunedDimension);
+    inner = std::min(std::get<2>(bucket), maximumTunedDimension);
+    cols = std::min(std::get<3>(bucket), maximumTunedDimension);
+    std::mt19937 generator(12345);
+    std::vector<T> hostA(static_cast<size_t>(rows) * inner);
+    std::vector<T> hostB(static_cast<size_t>(inner) * cols);
+    for (T& value : hostA) value = randomElement<T>(generator);
+    for (T& value : hostB) value = randomElement<T>(generator);
+    std::vector<Acc> expected(static_cast<size_t>(rows) * cols);
+    gemmCPU<T, Acc>(rows, inner, cols, hostA.data(), inner, hostB.data(), cols, expected.data(), cols);
+
+    cl_context context = runtime.getContext();
+    cl_int error;
+    cl_mem bufferA = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(T) * hostA.size(), hostA.data(), &error);
+    cl_mem bufferB = clCreateBuffer(context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(T) * hostB.size(), hostB.data(), &error);
+    cl_mem bufferC = clCreateBuffer(context, CL_MEM_WRITE_ONLY, sizeof(Acc) * expected.size(), nullptr, &error);
+
+    GemmConfig best;
+    if (bufferA && bufferB && bufferC) {
+        double bestTime = benchmark<T, Acc>(best, rows, inner, cols, bufferA, bufferB, bufferC, expected);
+
+        const int tiles[] = {16, 32, 64};
+        const int work[] = {1, 2, 4, 8};
+        const int widths[] = {1, 4};
+        for (int tile : tiles) {
+            for (int rowsPerItem : work) {
+                for (int colsPerItem : work) {
+                    for (int vectorWidth : widths) {
+                        GemmConfig candidate(tile, rowsPerItem, colsPerItem, vectorWidth);
+                        size_t local[2];
+                        candidate.localSize(local);
+                        // Too few threads cannot hide latency, too many outputs
+                        // per thread spill registers.
+                        if (local[0] * local[1] < 16 || rowsPerItem * colsPerItem > 32 || !fitsDevice(candidate, sizeof(T))) {
+                            continue;
+                        }
+                        double time = benchmark<T, Acc>(candidate, rows, inner, cols, bufferA, bufferB, bufferC, expected);
+                        if (time < bestTime) {
+                            bestTime = time;
+                            best = candidate;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (bufferA) clReleaseMemObject(bufferA);
+    if (bufferB) clReleaseMemObject(bufferB);
+    if (bufferC) clReleaseMemObject(bufferC);
+    configs[bucket] = best;
+    save();
+    return best;
+}
+
+void GemmAutotuner::load() {
+    if (tuningFile.empty()) {
+        return;
+    }
+    // One "type rows inner cols tile rowsPerItem colsPerItem vectorWidth"
+    // entry per line; anything else is skipped.
+    std::ifstream file(tuningFile);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string type;
+        int rows, inner, cols;
+        GemmConfig config;
+        if (fields >> type >> rows >> inner >> cols >> config.tile >> config.rowsPerItem >> config.colsPerItem >> config.vectorWidth) {
+            configs[Bucket(type, rows, inner, cols)] = config;
+        }
+    }
+}
+
+void GemmAutotuner::save() const {
+    if (tuningFile.empty()) {
+        return;
+    }
+    std::string temporary = tuningFile + ".tmp";
+    {
+        std::ofstream file(temporary);
+        if (!file) {
+            return;
+        }
+        for (const auto& entry : configs) {
+            const GemmConfig& config = entry.second;
+            file << std::get<0>(entry.first) << " " << std::get<1>(entry.first) << " " << std::get<2>(entry.first) << " "
+                 << std::get<3>(entry.first) << " " << config.tile << " " << config.rowsPerItem << " " << config.colsPerItem
+                 << " " << config.vectorWidth << "\n";
+        }
+    }
+    std::rename(temporary.c_str(), tuningFile.c_str());
+}
+
+template std::string openCLTypeDefines<float, float>();
+template std::string openCLTypeDefines<double, double>();
+template std::string openCLTypeDefines<int32_t, int32_t>();
+template std::string openCLTypeDefines<int64_t, int64_t>();
+template std::string openCLTypeDefines<int8_t, int32_t>();
+
+template cl_int enqueueGemm<float, float>(const GemmConfig&, cl_mem, cl_mem, cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemm<double, double>(const GemmConfig&, cl_mem, cl_mem, cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemm<int32_t, int32_t>(const GemmConfig&, cl_mem, cl_mem, cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemm<int64_t, int64_t>(const GemmConfig&, cl_mem, cl_mem, cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemm<int8_t, int32_t>(const GemmConfig&, cl_mem, cl_mem, cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+
+template bool buildGemmKernel<float, float>(const GemmConfig&, OpenCLRuntime&);
+template bool buildGemmKernel<double, double>(const GemmConfig&, OpenCLRuntime&);
+template bool buildGemmKernel<int32_t, int32_t>(const GemmConfig&, OpenCLRuntime&);
+template bool buildGemmKernel<int64_t, int64_t>(const GemmConfig&, OpenCLRuntime&);
+template bool buildGemmKernel<int8_t, int32_t>(const GemmConfig&, OpenCLRuntime&);
+
+template cl_int enqueueGemmFused<float, float>(const GemmConfig&, bool, bool, const GemmEpilogue<float>&, cl_mem, cl_mem, cl_mem,
+                                               cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemmFused<double, double>(const GemmConfig&, bool, bool, const GemmEpilogue<double>&, cl_mem, cl_mem, cl_mem,
+                                               cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemmFused<int32_t, int32_t>(const GemmConfig&, bool, bool, const GemmEpilogue<int32_t>&, cl_mem, cl_mem, cl_mem,
+                                               cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemmFused<int64_t, int64_t>(const GemmConfig&, bool, bool, const GemmEpilogue<int64_t>&, cl_mem, cl_mem, cl_mem,
+                                               cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+template cl_int enqueueGemmFused<int8_t, int32_t>(const GemmConfig&, bool, bool, const GemmEpilogue<int32_t>&, cl_mem, cl_mem, cl_mem,
+                                               cl_mem, int, int, int, int, int, int, cl_command_queue, OpenCLRuntime*);
+
+template GemmConfig GemmAutotuner::getConfig<float, float>(int, int, int);
+template GemmConfig GemmAutotuner::getConfig<double, double>(int, int, int);
+template GemmConfig GemmAutotuner::getConfig<int32_t, int32_t>(int, int, int);
+template GemmConfig GemmAutotuner::getConfig<int64_t, int64_t>(int, int, int);
+template GemmConfig GemmAutotuner::getConfig<int8_t, int32_t>(int, int, int);
@@ -0,0 +1,135 @@
+// opencl_gemm.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef OPENCL_GEMM_HPP
+#define OPENCL_GEMM_HPP
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "gemm_epilogue.hpp"
+#include "opencl_runtime.hpp"
+
+// OpenCL C spelling of an element type, and whether a device can run
+// kernels on it. double needs the cl_khr_fp64 extension.
+template <typename T>
+struct OpenCLElement {
+    static const char* name();
+    static bool isSupported(OpenCLRuntime& runtime = OpenCLRuntime::instance()) { return runtime.isAvailable(); }
+};
+
+template <> inline const char* OpenCLElement<float>::name() { return "float"; }
+template <> inline const char* OpenCLElement<double>::name() { return "double"; }
+template <> inline const char* OpenCLElement<int32_t>::name() { return "int"; }
+template <> inline const char* OpenCLElement<int64_t>::name() { return "long"; }
+template <> inline const char* OpenCLElement<int8_t>::name() { return "char"; }
+
+template <>
+inline bool OpenCLElement<double>::isSupported(OpenCLRuntime& runtime) {
+    return runtime.hasExtension("cl_khr_fp64");
+}
+
+// Source lines that define TYPE as T and ACC as Acc for kernels generated
+// per element type, enabling cl_khr_fp64 for double
+template <typename T, typename Acc>
+std::string openCLTypeDefines();
+
+// Compile-time parameters of the tiled GEMM kernel. Each work-group computes
+// a tile x tile block of C, staging tile x tile blocks of A and B in local
+// memory; each work-item accumulates rowsPerItem x colsPerItem outputs in
+// registers and loads operands vectorWidth elements at a time.
+//
+// tile == 0 selects the untiled one-output-per-work-item kernel.
+struct GemmConfig {
+    int tile;
+    int rowsPerItem;
+    int colsPerItem;
+    int vectorWidth;
+
+    GemmConfig();
+    GemmConfig(int tile, int rowsPerItem, int colsPerItem, int vectorWidth);
+
+    bool isTiled() const;
+    std::string kernelName() const;
+    std::string buildOptions() const;
+    void localSize(size_t local[2]) const;
+    void globalSize(int rows, int cols, size_t global[2]) const;
+};
+
+// Enqueues C = A * B on queue, or the runtime's queue if none is given.
+// A is rows x inner, B is inner x cols, all row-major with the given row
+// strides in elements. A and B hold T, C holds Acc; the kernel source is
+// generated for each pair. The buffers and queue belong to runtime, which
+// defaults to the shared one.
+template <typename T, typename Acc>
+cl_int enqueueGemm(const GemmConfig& config, cl_mem bufferA, cl_mem bufferB, cl_mem bufferC,
+                   int rows, int inner, int cols, int strideA, int strideB, int strideC,
+                   cl_command_queue queue = nullptr, OpenCLRuntime* runtime = nullptr);
+
+// Fused form of enqueueGemm: C = epilogue(op(A) * op(B)), where op
+// transposes an operand whose flag is set (see gemmCPU). bufferAddend holds
+// the epilogue's D, laid out by its strides, or is nullptr if there is none;
+// the epilogue's addend pointer is ignored. Each combination of transposes,
+// addend and op kinds builds its own program.
+template <typename T, typename Acc>
+cl_int enqueueGemmFused(const GemmConfig& config, bool transposeA, bool transposeB, const GemmEpilogue<Acc>& epilogue,
+                        cl_mem bufferA, cl_mem bufferB, cl_mem bufferC, cl_mem bufferAddend,
+                        int rows, int inner, int cols, int strideA, int strideB, int strideC,
+                        cl_command_queue queue = nullptr, OpenCLRuntime* runtime = nullptr);
+
+// Builds the kernel enqueueGemm launches for config on the runtime's
+// device, so the first launch does not pay for it. Returns false if it
+// fails to build.
+template <typename T, typename Acc>
+bool buildGemmKernel(const GemmConfig& config, OpenCLRuntime& runtime);
+
+// Picks the fastest GemmConfig per device, element type and matrix shape. Shapes are
+// grouped into power-of-two buckets; the first multiply in a bucket
+// benchmarks every candidate that fits the device and stores the winner in
+// the runtime cache directory, so later runs reuse it.
+//
+// Set PHY250_AUTOTUNE=0 to skip benchmarking and use a fixed default.
+class GemmAutotuner {
+public:
+    // The tuner for a device; there is one per runtime
+    static GemmAutotuner& instance(OpenCLRuntime& runtime = OpenCLRuntime::instance());
+
+    template <typename T, typename Acc>
+    GemmConfig getConfig(int rows, int inner, int cols);
+
+    // Benchmarks all candidates for the bucket holding this shape
+    template <typename T, typename Acc>
+    GemmConfig tune(int rows, int inner, int cols);
+
+private:
+    explicit GemmAutotuner(OpenCLRuntime& runtime);
+
+    // Element type name followed by the rounded shape
+    typedef std::tuple<std::string, int, int, int> Bucket;
+
+    template <typename T>
+    static Bucket bucketFor(int rows, int inner, int cols);
+    GemmConfig defaultConfig(size_t elementSize) const;
+    bool fitsDevice(const GemmConfig& config, size_t elementSize) const;
+    // Times config on a problem tune() set up, or returns infinity if the
+    // kernel fails or disagrees with expected
+    template <typename T, typename Acc>
+    double benchmark(const GemmConfig& config, int rows, int inner, int cols,
+                     cl_mem bufferA, cl_mem bufferB, cl_mem bufferC, const std::vector<Acc>& expected);
+    void load();
+    void save() const;
+
+    OpenCLRuntime& runtime;
+    bool enabled;
+    std::string tuningFile;
+    std::mutex tunerMutex;
+    std::map<Bucket, GemmConfig> configs;
+};
+
+#endif // OPENCL_GEMM_HPP
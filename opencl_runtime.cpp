@@ -0,0 +1,549 @@
+// opencl_runtime.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "opencl_runtime.hpp"
+#include "buffer_pool.hpp"
+#include "instrumentation.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+#include <sys/stat.h>
+
+namespace {
+
+// Recorded profiling events held before the finished ones are folded into
+// running totals
+const size_t profileEventLimit = 4096;
+
+uint64_t fnv1a(const std::string& text, uint64_t hash = 1469598103934665603ULL) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string deviceString(cl_device_id device, cl_device_info param) {
+    size_t size = 0;
+    if (clGetDeviceInfo(device, param, 0, nullptr, &size) != CL_SUCCESS || size == 0) {
+        return "";
+    }
+    std::string value(size, '\0');
+    clGetDeviceInfo(device, param, size, &value[0], nullptr);
+    value.resize(value.find('\0') == std::string::npos ? size : value.find('\0'));
+    return value;
+}
+
+// mkdir -p
+bool makeDirectories(const std::string& path) {
+    for (size_t pos = 1; pos <= path.size(); ++pos) {
+        if (pos == path.size() || path[pos] == '/') {
+            std::string prefix = path.substr(0, pos);
+            if (mkdir(prefix.c_str(), 0755) != 0) {
+                struct stat info;
+                if (stat(prefix.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void printBuildLog(cl_program program, cl_device_id device) {
+    size_t size = 0;
+    clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &size);
+    if (size > 1) {
+        std::string log(size, '\0');
+        clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, size, &log[0], nullptr);
+        std::cerr << log << std::endl;
+    }
+}
+
+} // namespace
+
+OpenCLRuntime& OpenCLRuntime::instance() {
+    // Function-local statics are initialized exactly once, even with
+    // concurrent callers.
+    static OpenCLRuntime runtime;
+    return runtime;
+}
+
+OpenCLRuntime::OpenCLRuntime() : platform(nullptr), device(nullptr), context(nullptr), commandQueue(nullptr) {
+    const char* selector = std::getenv("PHY250_CL_DEVICES");
+    std::vector<OpenCLDeviceInfo> selected = selectDevices(selector != nullptr ? selector : "");
+    if (selected.empty()) {
+        if (listDevices().empty()) {
+            std::cerr << "Error: No OpenCL devices available." << std::endl;
+        } else {
+            std::cerr << "Error: No OpenCL device matches PHY250_CL_DEVICES=" << selector << std::endl;
+        }
+    }
+    initialize(selected.empty() ? nullptr : &selected[0]);
+}
+
+OpenCLRuntime::OpenCLRuntime(const OpenCLDeviceInfo& info)
+    : platform(nullptr), device(nullptr), context(nullptr), commandQueue(nullptr) {
+    initialize(&info);
+}
+
+void OpenCLRuntime::initialize(const OpenCLDeviceInfo* info) {
+    const char* profileSetting = std::getenv("PHY250_CL_PROFILE");
+    profiling = profileSetting != nullptr && std::atoi(profileSetting) > 0;
+    if (info != nullptr) {
+        initializeOpenCL(*info);
+    }
+    bufferPool.reset(new BufferPool(*this));
+
+    const char* cacheOverride = std::getenv("PHY250_CL_CACHE");
+    if (cacheOverride != nullptr) {
+        cacheDirectory = cacheOverride;
+    } else if (const char* xdg = std::getenv("XDG_CACHE_HOME")) {
+        cacheDirectory = std::string(xdg) + "/phy250";
+    } else if (const char* home = std::getenv("HOME")) {
+        cacheDirectory = std::string(home) + "/.cache/phy250";
+    }
+    if (!cacheDirectory.empty() && !makeDirectories(cacheDirectory)) {
+        std::cerr << "Warning: Cannot create OpenCL cache directory " << cacheDirectory << std::endl;
+        cacheDirectory.clear();
+    }
+}
+
+OpenCLRuntime::~OpenCLRuntime() {
+    // Pooled buffers go before the context they belong to
+    bufferPool.reset();
+    for (auto& entry : profileEvents) {
+        if (entry.second) clReleaseEvent(entry.second);
+    }
+    for (auto& entry : kernels) {
+        clReleaseKernel(entry.second);
+    }
+    for (auto& entry : programs) {
+        if (entry.second) {
+            clReleaseProgram(entry.second);
+        }
+    }
+    for (cl_command_queue queue : queues) {
+        clReleaseCommandQueue(queue);
+    }
+    if (context) {
+        clReleaseContext(context);
+    }
+}
+
+std::vector<OpenCLDeviceInfo> OpenCLRuntime::listDevices() {
+    std::vector<OpenCLDeviceInfo> found;
+    cl_uint numPlatforms = 0;
+    if (clGetPlatformIDs(0, nullptr, &numPlatforms) != CL_SUCCESS || numPlatforms == 0) {
+        return found;
+    }
+    std::vector<cl_platform_id> platforms(numPlatforms);
+    if (clGetPlatformIDs(numPlatforms, platforms.data(), nullptr) != CL_SUCCESS) {
+        return found;
+    }
+
+    for (cl_uint p = 0; p < numPlatforms; ++p) {
+        cl_uint numDevices = 0;
+        if (clGetDeviceIDs(platforms[p], CL_DEVICE_TYPE_ALL, 0, nullptr, &numDevices) != CL_SUCCESS || numDevices == 0) {
+            continue;
+        }
+        std::vector<cl_device_id> devices(numDevices);
+        if (clGetDeviceIDs(platforms[p], CL_DEVICE_TYPE_ALL, numDevices, devices.data(), nullptr) != CL_SUCCESS) {
+            continue;
+        }
+        for (cl_uint d = 0; d < numDevices; ++d) {
+            OpenCLDeviceInfo info;
+            info.platformIndex = static_cast<int>(p);
+            info.deviceIndex = static_cast<int>(d);
+            info.platform = platforms[p];
+            info.device = devices[d];
+            info.type = 0;
+            clGetDeviceInfo(devices[d], CL_DEVICE_TYPE, sizeof(info.type), &info.type, nullptr);
+            info.name = deviceString(devices[d], CL_DEVICE_NAME);
+            found.push_back(info);
+        }
+    }
+    return found;
+}
+
+std::vector<OpenCLDeviceInfo> OpenCLRuntime::selectDevices(const std::string& selector) {
+    std::vector<OpenCLDeviceInfo> devices = listDevices();
+    std::vector<std::string> items;
+    std::istringstream stream(selector.empty() ? "all" : selector);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+
+    std::vector<OpenCLDeviceInfo> selected;
+    for (const OpenCLDeviceInfo& info : devices) {
+        std::string location = std::to_string(info.platformIndex) + ":" + std::to_string(info.deviceIndex);
+        bool matches = false;
+        for (const std::string& wanted : items) {
+            matches = matches || wanted == "all" || wanted == location ||
+                      (wanted == "gpu" && (info.type & CL_DEVICE_TYPE_GPU)) ||
+                      (wanted == "cpu" && (info.type & CL_DEVICE_TYPE_CPU)) ||
+                      (wanted == "accelerator" && (info.type & CL_DEVICE_TYPE_ACCELERATOR)) ||
+                      (wanted.find(':') == std::string::npos && info.name.find(wanted) != std::string::npos);
+        }
+        if (matches) {
+            selected.push_back(info);
+        }
+    }
+    return selected;
+}
+
+void OpenCLRuntime::initializeOpenCL(const OpenCLDeviceInfo& info) {
+    PHY250_TIME_SCOPE("initializeOpenCL");
+    cl_int error;
+    platform = info.platform;
+    device = info.device;
+
+    context = clCreateContext(nullptr, 1, &device, nullptr, nullptr, &error);
+    if (error != CL_SUCCESS) {
+      std::cerr << "ERROR Creating context" << std::endl;
+      context = nullptr;
+      return;
+    }
+
+    const char* queueSetting = std::getenv("PHY250_CL_QUEUES");
+    int queueCount = queueSetting != nullptr && std::atoi(queueSetting) > 0 ? std::atoi(queueSetting) : 2;
+    for (int i = 0; i < queueCount; ++i) {
+        cl_command_queue queue = clCreateCommandQueue(context, device, profiling ? CL_QUEUE_PROFILING_ENABLE : 0, &error);
+        if (error != CL_SUCCESS) {
+            break;
+        }
+        queues.push_back(queue);
+    }
+    if (queues.empty()) {
+      std::cerr << "ERROR Creating command queue" << std::endl;
+      return;
+    }
+    commandQueue = queues[0];
+
+    deviceSignature = deviceString(device, CL_DEVICE_NAME) + "|" + deviceString(device, CL_DEVICE_VENDOR) + "|" +
+                      deviceString(device, CL_DEVICE_VERSION) + "|" + deviceString(device, CL_DRIVER_VERSION);
+}
+
+bool OpenCLRuntime::isAvailable() const {
+    return context != nullptr && commandQueue != nullptr;
+}
+
+bool OpenCLRuntime::hasExtension(const std::string& name) const {
+    if (!isAvailable()) {
+        return false;
+    }
+    std::istringstream extensions(deviceString(device, CL_DEVICE_EXTENSIONS));
+    std::string extension;
+    while (extensions >> extension) {
+        if (extension == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
+cl_context OpenCLRuntime::getContext() const {
+    return context;
+}
+
+cl_device_id OpenCLRuntime::getDevice() const {
+    return device;
+}
+
+cl_command_queue OpenCLRuntime::getQueue() const {
+    return commandQueue;
+}
+
+int OpenCLRuntime::getQueueCount() const {
+    return static_cast<int>(queues.size());
+}
+
+cl_command_queue OpenCLRuntime::getQueue(int index) const {
+    return queues[index];
+}
+
+void OpenCLRuntime::finish() {
+    for (cl_command_queue queue : queues) {
+        clFinish(queue);
+    }
+}
+
+std::mutex& OpenCLRuntime::lock() {
+    return runtimeMutex;
+}
+
+bool OpenCLRuntime::isProfiling() const {
+    return profiling;
+}
+
+cl_event* OpenCLRuntime::profileEvent(ProfilePhase phase) {
+    if (!profiling) {
+        return nullptr;
+    }
+    // List elements never move, so the slot stays valid while the enqueue
+    // fills it in; a failed enqueue leaves it null.
+    std::lock_guard<std::mutex> guard(profileMutex);
+    if (profileEvents.size() >= profileEventLimit) {
+        foldProfileEvents(false);
+    }
+    profileEvents.emplace_back(phase, nullptr);
+    return &profileEvents.back().second;
+}
+
+void OpenCLRuntime::recordEvent(ProfilePhase phase, cl_event event) {
+    if (!profiling || event == nullptr) {
+        return;
+    }
+    clRetainEvent(event);
+    std::lock_guard<std::mutex> guard(profileMutex);
+    if (profileEvents.size() >= profileEventLimit) {
+        foldProfileEvents(false);
+    }
+    profileEvents.emplace_back(phase, event);
+}
+
+void OpenCLRuntime::foldProfileEvents(bool wait) {
+    auto fold = [this](const std::pair<ProfilePhase, cl_event>& entry) {
+        cl_ulong start = 0;
+        cl_ulong end = 0;
+        clGetEventProfilingInfo(entry.second, CL_PROFILING_COMMAND_START, sizeof(start), &start, nullptr);
+        clGetEventProfilingInfo(entry.second, CL_PROFILING_COMMAND_END, sizeof(end), &end, nullptr);
+        clReleaseEvent(entry.second);
+
+        double seconds = end > start ? (end - start) * 1e-9 : 0.0;
+        if (entry.first == ProfileWrite) {
+            profileTotals.writeSeconds += seconds;
+        } else if (entry.first == ProfileKernel) {
+            profileTotals.kernelSeconds += seconds;
+        } else {
+            profileTotals.readSeconds += seconds;
+        }
+    };
+
+    // The newest null slots may still be filled in by enqueues in flight;
+    // older ones are failed enqueues and are dropped
+    const size_t pendingSlots = 64;
+    size_t index = 0;
+    const size_t count = profileEvents.size();
+    for (auto entry = profileEvents.begin(); entry != profileEvents.end(); ++index) {
+        bool finished = false;
+        if (entry->second != nullptr) {
+            cl_int status = CL_QUEUED;
+            if (wait) {
+                clWaitForEvents(1, &entry->second);
+                status = CL_COMPLETE;
+            } else {
+                clGetEventInfo(entry->second, CL_EVENT_COMMAND_EXECUTION_STATUS, sizeof(status), &status, nullptr);
+            }
+            if (status == CL_COMPLETE || status < 0) {
+                fold(*entry);
+                finished = true;
+            }
+        } else {
+            finished = wait || index + pendingSlots < count;
+        }
+        entry = finished ? profileEvents.erase(entry) : std::next(entry);
+    }
+
+    while (profileEvents.size() >= profileEventLimit / 2) {
+        auto oldest = profileEvents.begin();
+        while (oldest != profileEvents.end() && oldest->second == nullptr) {
+            ++oldest;
+        }
+        if (oldest == profileEvents.end()) {
+            break;
+        }
+        clWaitForEvents(1, &oldest->second);
+        fold(*oldest);
+        profileEvents.erase(oldest);
+    }
+}
+
+OpenCLProfile OpenCLRuntime::takeProfile() {
+    finish();
+
+    std::lock_guard<std::mutex> guard(profileMutex);
+    foldProfileEvents(true);
+    OpenCLProfile profile = profileTotals;
+    profileTotals = OpenCLProfile{0.0, 0.0, 0.0};
+    return profile;
+}
+
+const std::string& OpenCLRuntime::getCacheDirectory() const {
+    return cacheDirectory;
+}
+
+std::string OpenCLRuntime::devicePrefix() const {
+    std::string deviceName = deviceString(device, CL_DEVICE_NAME);
+    std::string prefix;
+    for (char c : deviceName) {
+        bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+        prefix += safe ? c : '_';
+    }
+    return prefix;
+}
+
+std::string OpenCLRuntime::cachePath(const std::string& source, const std::string& options) const {
+    if (cacheDirectory.empty()) {
+        return "";
+    }
+
+    // The device name alone is not enough: a driver update changes the binary
+    // format, so the full device signature is part of the hash.
+    uint64_t hash = fnv1a(source, fnv1a(options, fnv1a(deviceSignature)));
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+    return cacheDirectory + "/" + devicePrefix() + "-" + hex + ".bin";
+}
+
+std::string OpenCLRuntime::getCacheFile(const std::string& name) const {
+    if (cacheDirectory.empty() || !isAvailable()) {
+        return "";
+    }
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(fnv1a(deviceSignature)));
+    return cacheDirectory + "/" + devicePrefix() + "-" + hex + "-" + name;
+}
+
+BufferPool& OpenCLRuntime::getBufferPool() {
+    return *bufferPool;
+}
+
+cl_program OpenCLRuntime::loadCachedProgram(const std::string& path, const std::string& options) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return nullptr;
+    }
+    std::vector<unsigned char> binary((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (binary.empty()) {
+        return nullptr;
+    }
+
+    const unsigned char* binaryData = binary.data();
+    size_t binarySize = binary.size();
+    cl_int status;
+    cl_int error;
+    cl_program program = clCreateProgramWithBinary(context, 1, &device, &binarySize, &binaryData, &status, &error);
+    if (error != CL_SUCCESS || status != CL_SUCCESS) {
+        if (program) {
+            clReleaseProgram(program);
+        }
+        return nullptr;
+    }
+
+    if (clBuildProgram(program, 1, &device, options.c_str(), nullptr, nullptr) != CL_SUCCESS) {
+        clReleaseProgram(program);
+        return nullptr;
+    }
+    return program;
+}
+
+void OpenCLRuntime::saveCachedProgram(cl_program program, const std::string& path) const {
+    size_t binarySize = 0;
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binarySize, nullptr) != CL_SUCCESS ||
+        binarySize == 0) {
+        return;
+    }
+
+    std::vector<unsigned char> binary(binarySize);
+    unsigned char* binaryData = binary.data();
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(unsigned char*), &binaryData, nullptr) != CL_SUCCESS) {
+        return;
+    }
+
+    // Write to a temporary name and rename, so a concurrent process never
+    // reads a half-written binary.
+    std::ostringstream temporary;
+    temporary << path << ".tmp" << std::hex << fnv1a(path, reinterpret_cast<uintptr_t>(this));
+    {
+        std::ofstream file(temporary.str(), std::ios::binary);
+        if (!file) {
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(binary.data()), binary.size());
+        if (!file) {
+            std::remove(temporary.str().c_str());
+            return;
+        }
+    }
+    if (std::rename(temporary.str().c_str(), path.c_str()) != 0) {
+        std::remove(temporary.str().c_str());
+    }
+}
+
+cl_program OpenCLRuntime::getProgram(const std::string& source, const std::string& options) {
+    if (!isAvailable()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(buildMutex);
+    auto key = std::make_pair(source, options);
+    auto found = programs.find(key);
+    if (found != programs.end()) {
+        return found->second;
+    }
+
+    PHY250_TIME_SCOPE("buildProgram");
+    std::string path = cachePath(source, options);
+    cl_program program = path.empty() ? nullptr : loadCachedProgram(path, options);
+    PHY250_COUNT(ProgramCacheLoads, program != nullptr ? 1 : 0);
+
+    if (program == nullptr) {
+        PHY250_COUNT(ProgramBuilds, 1);
+        const char* sourceText = source.c_str();
+        cl_int error;
+        program = clCreateProgramWithSource(context, 1, &sourceText, nullptr, &error);
+        if (error == CL_SUCCESS) {
+            error = clBuildProgram(program, 1, &device, options.c_str(), nullptr, nullptr);
+        }
+        if (error != CL_SUCCESS) {
+            std::cerr << "ERROR Building program" << std::endl;
+            if (program) {
+                printBuildLog(program, device);
+                clReleaseProgram(program);
+            }
+            program = nullptr;
+        } else if (!path.empty()) {
+            saveCachedProgram(program, path);
+        }
+    }
+
+    // Failed builds are remembered too, so a broken kernel is reported once
+    // instead of being recompiled on every call.
+    programs[key] = program;
+    return program;
+}
+
+cl_kernel OpenCLRuntime::getKernel(const std::string& source, const std::string& name, const std::string& options) {
+    cl_program program = getProgram(source, options);
+    if (program == nullptr) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> guard(buildMutex);
+    auto key = std::make_pair(program, name);
+    auto found = kernels.find(key);
+    if (found != kernels.end()) {
+        return found->second;
+    }
+
+    cl_int error;
+    cl_kernel kernel = clCreateKernel(program, name.c_str(), &error);
+    if (error != CL_SUCCESS) {
+        std::cerr << "ERROR Creating kernel " << name << std::endl;
+        return nullptr;
+    }
+    kernels[key] = kernel;
+    return kernel;
+}
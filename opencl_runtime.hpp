@@ -0,0 +1,169 @@
+// opencl_runtime.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef CL_TARGET_OPENCL_VERSION
+#define CL_TARGET_OPENCL_VERSION 120
+#endif
+
+#ifndef OPENCL_RUNTIME_HPP
+#define OPENCL_RUNTIME_HPP
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __APPLE__
+#include <OpenCL/opencl.h>
+#else
+#include <CL/cl.h>
+#endif
+
+// Device time spent in each kind of command, in seconds
+struct OpenCLProfile {
+    double writeSeconds;
+    double kernelSeconds;
+    double readSeconds;
+};
+
+class BufferPool;
+
+// An OpenCL device as enumerated by OpenCLRuntime::listDevices
+struct OpenCLDeviceInfo {
+    int platformIndex;
+    int deviceIndex;
+    cl_platform_id platform;
+    cl_device_id device;
+    cl_device_type type;
+    std::string name;
+};
+
+// Process-wide OpenCL state shared by every Matrix. The first call to
+// instance() picks the device, creates the context and queue; programs are
+// built once per (source, options) pair and their binaries are cached on
+// disk so later runs skip the compiler.
+//
+// instance() uses the first device selected by PHY250_CL_DEVICES (see
+// selectDevices), which by default is the first device of the first
+// platform. DeviceGroup holds a runtime for each of the other selected
+// devices.
+//
+// Kernel objects are shared, so callers must hold lock() between setting
+// kernel arguments and enqueueing the kernel.
+class OpenCLRuntime {
+public:
+    static OpenCLRuntime& instance();
+
+    // Every device of every platform, in platform then device order
+    static std::vector<OpenCLDeviceInfo> listDevices();
+
+    // The devices matching a comma-separated selector, in listDevices
+    // order. Each item is "all", a device type ("gpu", "cpu",
+    // "accelerator"), a "platform:device" index pair, or part of a device
+    // name. An empty selector means "all".
+    static std::vector<OpenCLDeviceInfo> selectDevices(const std::string& selector);
+
+    bool isAvailable() const;
+
+    // True if the device lists the extension, e.g. "cl_khr_fp64"
+    bool hasExtension(const std::string& name) const;
+
+    cl_context getContext() const;
+    cl_device_id getDevice() const;
+    cl_command_queue getQueue() const;
+    std::mutex& lock();
+
+    // In-order queues on the device; queue 0 is getQueue(). Independent
+    // work spread over several queues lets transfers overlap kernels. Set
+    // PHY250_CL_QUEUES to change the count (default 2).
+    int getQueueCount() const;
+    cl_command_queue getQueue(int index) const;
+
+    // Waits for every queue to drain
+    void finish();
+
+    // Profiling. With PHY250_CL_PROFILE=1 the queues record timestamps and
+    // the library times its transfers and kernels. Enqueues pass
+    // profileEvent(phase) as their event argument; it is nullptr when
+    // profiling is off. Commands that need their own event hand it to
+    // recordEvent instead. The runtime holds a few thousand events at most;
+    // past that, finished ones are folded into running totals, waiting for
+    // the oldest if none has finished. Programs that profile should still
+    // drain the totals with takeProfile() now and then.
+    enum ProfilePhase { ProfileWrite, ProfileKernel, ProfileRead };
+    bool isProfiling() const;
+    cl_event* profileEvent(ProfilePhase phase);
+    void recordEvent(ProfilePhase phase, cl_event event);
+
+    // Waits for the recorded commands and returns their total times since
+    // the last call. Nothing else may be enqueueing meanwhile.
+    OpenCLProfile takeProfile();
+
+    // Returns a built program, or nullptr if it fails to build
+    cl_program getProgram(const std::string& source, const std::string& options = "");
+
+    // Returns a kernel from the program built for source and options
+    cl_kernel getKernel(const std::string& source, const std::string& name, const std::string& options = "");
+
+    // Directory holding cached program binaries, empty if caching is disabled.
+    // Set PHY250_CL_CACHE to override, or to an empty string to disable.
+    const std::string& getCacheDirectory() const;
+
+    // Path of a per-device file in the cache directory, empty if disabled
+    std::string getCacheFile(const std::string& name) const;
+
+    // Scratch device buffers and pinned staging buffers for this device
+    BufferPool& getBufferPool();
+
+private:
+    friend class DeviceGroup;
+
+    OpenCLRuntime();
+    explicit OpenCLRuntime(const OpenCLDeviceInfo& info);
+    ~OpenCLRuntime();
+
+    OpenCLRuntime(const OpenCLRuntime&) = delete;
+    OpenCLRuntime& operator=(const OpenCLRuntime&) = delete;
+
+    void initialize(const OpenCLDeviceInfo* info);
+    void initializeOpenCL(const OpenCLDeviceInfo& info);
+    std::string devicePrefix() const;
+    std::string cachePath(const std::string& source, const std::string& options) const;
+    cl_program loadCachedProgram(const std::string& path, const std::string& options);
+    void saveCachedProgram(cl_program program, const std::string& path) const;
+
+    cl_platform_id platform;
+    cl_device_id device;
+    cl_context context;
+    cl_command_queue commandQueue;
+    std::vector<cl_command_queue> queues;
+
+    // Adds the finished recorded events to profileTotals and releases them.
+    // With wait, waits for every event first; otherwise, if too many are
+    // still running, waits for the oldest. Needs profileMutex.
+    void foldProfileEvents(bool wait);
+
+    bool profiling;
+    std::mutex profileMutex;
+    // A list, so folding events out of the middle never moves the slots
+    // that profileEvent handed out
+    std::list<std::pair<ProfilePhase, cl_event>> profileEvents;
+    OpenCLProfile profileTotals = {0.0, 0.0, 0.0};
+
+    std::string deviceSignature;
+    std::string cacheDirectory;
+
+    std::mutex runtimeMutex;
+    std::mutex buildMutex;
+    std::map<std::pair<std::string, std::string>, cl_program> programs;
+    std::map<std::pair<cl_program, std::string>, cl_kernel> kernels;
+
+    std::unique_ptr<BufferPool> bufferPool;
+};
+
+#endif // OPENCL_RUNTIME_HPP
@@ -0,0 +1,554 @@
+// sparse_matrix.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "sparse_matrix.hpp"
+#include "buffer_pool.hpp"
+#include "instrumentation.hpp"
+#include "opencl_gemm.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+
+namespace {
+
+// Kernels for C = S * B with S sparse and B dense. Work-item (col, row)
+// computes one element of C, so neighbouring work-items read neighbouring
+// elements of a row of B. A sparse x vector product is the same launch with
+// a single column.
+const char* sparseKernelBody = R"(
+    __kernel void csrMultiply(__global const int* rowOffsets,
+                              __global const int* columns,
+                              __global const TYPE* values,
+                              __global const TYPE* B,
+                              __global ACC* C,
+                              const int rows,
+                              const int cols,
+                              const int strideB,
+                              const int strideC) {
+        const int col = get_global_id(0);
+        const int row = get_global_id(1);
+        if (row >= rows || col >= cols) {
+            return;
+        }
+
+        ACC sum = 0;
+        const int end = rowOffsets[row + 1];
+        for (int k = rowOffsets[row]; k < end; ++k) {
+            sum += (ACC)values[k] * (ACC)B[columns[k] * strideB + col];
+        }
+        C[row * strideC + col] = sum;
+    }
+
+    // ELL: entry k of every row is stored at k * rows + row, and rows
+    // shorter than width are padded with column -1.
+    __kernel void ellMultiply(__global const int* columns,
+                              __global const TYPE* values,
+                              const int width,
+                              __global const TYPE* B,
+                              __global ACC* C,
+                              const int rows,
+                              const int cols,
+                              const int strideB,
+                              const int strideC) {
+        const int col = get_global_id(0);
+        const int row = get_global_id(1);
+        if (row >= rows || col >= cols) {
+            return;
+        }
+
+        ACC sum = 0;
+        for (int k = 0; k < width; ++k) {
+            const int column = columns[k * rows + row];
+            if (column < 0) {
+                break;
+            }
+            sum += (ACC)values[k * rows + row] * (ACC)B[column * strideB + col];
+        }
+        C[row * strideC + col] = sum;
+    }
+)";
+
+// ELL is used while padding at most doubles the stored entries
+const double maximumEllPadding = 2.0;
+
+// Sparse products below this many multiply-adds run on one thread
+const double parallelWork = 1 << 15;
+
+template <typename T, typename Acc>
+const std::string& sparseSource() {
+    static const std::string source = openCLTypeDefines<T, Acc>() + sparseKernelBody;
+    return source;
+}
+
+// Splits rows into about count chunks holding similar numbers of nonzeros,
+// so one dense row does not leave the other threads idle
+std::vector<int> balancedRowChunks(const std::vector<int>& rowOffsets, int count) {
+    int rows = static_cast<int>(rowOffsets.size()) - 1;
+    long long nonZeros = rowOffsets.back();
+    std::vector<int> bounds(1, 0);
+    for (int chunk = 1; chunk < count; ++chunk) {
+        long long target = nonZeros * chunk / count;
+        int row = static_cast<int>(std::lower_bound(rowOffsets.begin(), rowOffsets.end(), target) - rowOffsets.begin());
+        row = std::min(row, rows);
+        if (row > bounds.back()) {
+            bounds.push_back(row);
+        }
+    }
+    if (bounds.back() < rows) {
+        bounds.push_back(rows);
+    }
+    return bounds;
+}
+
+// Calls body(begin, end) over row ranges, in parallel when worth it
+void forRowChunks(const std::vector<int>& rowOffsets, double work, const std::function<void(int, int)>& body) {
+    int rows = static_cast<int>(rowOffsets.size()) - 1;
+    ThreadPool& pool = ThreadPool::instance();
+    if (work < parallelWork || pool.getThreadCount() == 1) {
+        body(0, rows);
+        return;
+    }
+    std::vector<int> bounds = balancedRowChunks(rowOffsets, pool.getThreadCount() * 4);
+    pool.parallelFor(static_cast<int>(bounds.size()) - 1, [&](int chunk) {
+        body(bounds[chunk], bounds[chunk + 1]);
+    });
+}
+
+cl_mem createReadOnlyBuffer(size_t bytes, const void* host) {
+    cl_int error;
+    // Buffers cannot be empty; an all-zero matrix still gets one element
+    static const int64_t placeholder = 0;
+    if (bytes == 0) {
+        bytes = sizeof(placeholder);
+        host = &placeholder;
+    }
+    return clCreateBuffer(OpenCLRuntime::instance().getContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR,
+                          bytes, const_cast<void*>(host), &error);
+}
+
+} // namespace
+
+template <typename T>
+struct SparseMatrix<T>::DeviceCopy {
+    bool ell;
+    int ellWidth;
+    cl_mem buffers[3];
+
+    DeviceCopy() : ell(false), ellWidth(0), buffers{nullptr, nullptr, nullptr} {
+    }
+
+    ~DeviceCopy() {
+        for (cl_mem buffer : buffers) {
+            if (buffer) clReleaseMemObject(buffer);
+        }
+    }
+};
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix() : rows(0), cols(0), rowOffsets(1, 0) {
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(int rows, int cols, const std::vector<int>& rowOffsets,
+                              const std::vector<int>& columnIndices, const std::vector<T>& values)
+    : rows(rows), cols(cols), rowOffsets(rowOffsets), columnIndices(columnIndices), values(values) {
+    bool valid = rows >= 0 && cols >= 0 && static_cast<int>(rowOffsets.size()) == rows + 1 &&
+                 rowOffsets.front() == 0 && columnIndices.size() == values.size() &&
+                 rowOffsets.back() == static_cast<int>(values.size());
+    for (int r = 0; valid && r < rows; ++r) {
+        valid = rowOffsets[r] <= rowOffsets[r + 1];
+        for (int k = rowOffsets[r]; valid && k < rowOffsets[r + 1]; ++k) {
+            valid = columnIndices[k] >= 0 && columnIndices[k] < cols &&
+                    (k == rowOffsets[r] || columnIndices[k - 1] < columnIndices[k]);
+        }
+    }
+    if (!valid) {
+        std::cerr << "Error: Invalid CSR arrays." << std::endl;
+        *this = SparseMatrix();
+    }
+}
+
+template <typename T>
+SparseMatrix<T>::SparseMatrix(int rows, int cols, const std::vector<std::tuple<int, int, T>>& entries)
+    : rows(rows), cols(cols), rowOffsets(rows + 1, 0) {
+    std::vector<std::tuple<int, int, T>> sorted;
+    sorted.reserve(entries.size());
+    for (const auto& entry : entries) {
+        int r = std::get<0>(entry);
+        int c = std::get<1>(entry);
+        if (r < 0 || r >= rows || c < 0 || c >= cols) {
+            std::cerr << "Error: Sparse entry (" << r << ", " << c << ") is outside the matrix." << std::endl;
+            continue;
+        }
+        sorted.push_back(entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const std::tuple<int, int, T>& a, const std::tuple<int, int, T>& b) {
+        return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : std::get<1>(a) < std::get<1>(b);
+    });
+
+    for (size_t i = 0; i < sorted.size();) {
+        int r = std::get<0>(sorted[i]);
+        int c = std::get<1>(sorted[i]);
+        T sum = 0;
+        for (; i < sorted.size() && std::get<0>(sorted[i]) == r && std::get<1>(sorted[i]) == c; ++i) {
+            sum += std::get<2>(sorted[i]);
+        }
+        if (sum != T(0)) {
+            columnIndices.push_back(c);
+            values.push_back(sum);
+            ++rowOffsets[r + 1];
+        }
+    }
+    for (int r = 0; r < rows; ++r) {
+        rowOffsets[r + 1] += rowOffsets[r];
+    }
+}
+
+template <typename T>
+SparseMatrix<T> SparseMatrix<T>::fromDense(const Matrix<T>& dense) {
+    SparseMatrix result;
+    result.rows = dense.getRows();
+    result.cols = dense.getCols();
+    result.rowOffsets.assign(result.rows + 1, 0);
+    for (int r = 0; r < result.rows; ++r) {
+        const T* source = dense.row(r);
+        for (int c = 0; c < result.cols; ++c) {
+            if (source[c] != T(0)) {
+                result.columnIndices.push_back(c);
+                result.values.push_back(source[c]);
+            }
+        }
+        result.rowOffsets[r + 1] = static_cast<int>(result.values.size());
+    }
+    return result;
+}
+
+template <typename T>
+Matrix<T> SparseMatrix<T>::toDense() const {
+    Matrix<T> dense(rows, cols);
+    if (rows == 0 || cols == 0) {
+        return dense;
+    }
+    T* data = dense.data();
+    int stride = dense.getStride();
+    for (int r = 0; r < rows; ++r) {
+        for (int k = rowOffsets[r]; k < rowOffsets[r + 1]; ++k) {
+            data[static_cast<size_t>(r) * stride + columnIndices[k]] = values[k];
+        }
+    }
+    return dense;
+}
+
+template <typename T>
+int SparseMatrix<T>::getRows() const {
+    return rows;
+}
+
+template <typename T>
+int SparseMatrix<T>::getCols() const {
+    return cols;
+}
+
+template <typename T>
+int SparseMatrix<T>::getNonZeros() const {
+    return static_cast<int>(values.size());
+}
+
+template <typename T>
+double SparseMatrix<T>::getDensity() const {
+    return rows > 0 && cols > 0 ? static_cast<double>(values.size()) / rows / cols : 0.0;
+}
+
+template <typename T>
+T SparseMatrix<T>::getElement(int row, int col) const {
+    auto begin = columnIndices.begin() + rowOffsets[row];
+    auto end = columnIndices.begin() + rowOffsets[row + 1];
+    auto found = std::lower_bound(begin, end, col);
+    return found != end && *found == col ? values[found - columnIndices.begin()] : T(0);
+}
+
+template <typename T>
+const std::vector<int>& SparseMatrix<T>::getRowOffsets() const {
+    return rowOffsets;
+}
+
+template <typename T>
+const std::vector<int>& SparseMatrix<T>::getColumnIndices() const {
+    return columnIndices;
+}
+
+template <typename T>
+const std::vector<T>& SparseMatrix<T>::getValues() const {
+    return values;
+}
+
+template <typename T>
+Matrix<typename SparseMatrix<T>::ResultType> SparseMatrix<T>::multiplyCPU(const Matrix<T>& dense) const {
+    if (cols != dense.getRows()) {
+        return Matrix<ResultType>();
+    }
+
+    Matrix<ResultType> result(rows, dense.getCols());
+    if (rows == 0 || dense.getCols() == 0) {
+        return result;
+    }
+
+    const T* B = dense.data();
+    const int strideB = dense.getStride();
+    const int width = dense.getCols();
+    ResultType* C = result.data();
+    const int strideC = result.getStride();
+
+    // Each nonzero scales a row of B into the row of C, which vectorizes
+    // over the columns.
+    forRowChunks(rowOffsets, static_cast<double>(values.size()) * width, [&](int begin, int end) {
+        for (int r = begin; r < end; ++r) {
+            ResultType* c = C + static_cast<size_t>(r) * strideC;
+            for (int k = rowOffsets[r]; k < rowOffsets[r + 1]; ++k) {
+                const ResultType value = values[k];
+                const T* b = B + static_cast<size_t>(columnIndices[k]) * strideB;
+                for (int j = 0; j < width; ++j) {
+                    c[j] += value * static_cast<ResultType>(b[j]);
+                }
+            }
+        }
+    });
+
+    return result;
+}
+
+template <typename T>
+std::vector<typename SparseMatrix<T>::ResultType> SparseMatrix<T>::multiplyCPU(const std::vector<T>& vector) const {
+    if (cols != static_cast<int>(vector.size())) {
+        return std::vector<ResultType>();
+    }
+
+    std::vector<ResultType> result(rows);
+    forRowChunks(rowOffsets, static_cast<double>(values.size()), [&](int begin, int end) {
+        for (int r = begin; r < end; ++r) {
+            ResultType sum = 0;
+            for (int k = rowOffsets[r]; k < rowOffsets[r + 1]; ++k) {
+                sum += static_cast<ResultType>(values[k]) * static_cast<ResultType>(vector[columnIndices[k]]);
+            }
+            result[r] = sum;
+        }
+    });
+    return result;
+}
+
+template <typename T>
+bool SparseMatrix<T>::usesEll() const {
+    int width = 0;
+    for (int r = 0; r < rows; ++r) {
+        width = std::max(width, rowOffsets[r + 1] - rowOffsets[r]);
+    }
+    return static_cast<double>(width) * rows <= maximumEllPadding * std::max<size_t>(values.size(), 1);
+}
+
+template <typename T>
+const typename SparseMatrix<T>::DeviceCopy* SparseMatrix<T>::getDeviceCopy() const {
+    if (device) {
+        return device.get();
+    }
+
+    auto copy = std::make_shared<DeviceCopy>();
+    copy->ell = usesEll();
+    if (copy->ell) {
+        for (int r = 0; r < rows; ++r) {
+            copy->ellWidth = std::max(copy->ellWidth, rowOffsets[r + 1] - rowOffsets[r]);
+        }
+        size_t entries = static_cast<size_t>(copy->ellWidth) * rows;
+        std::vector<int> ellColumns(entries, -1);
+        std::vector<T> ellValues(entries, T(0));
+        for (int r = 0; r < rows; ++r) {
+            for (int k = rowOffsets[r]; k < rowOffsets[r + 1]; ++k) {
+                size_t slot = static_cast<size_t>(k - rowOffsets[r]) * rows + r;
+                ellColumns[slot] = columnIndices[k];
+                ellValues[slot] = values[k];
+            }
+        }
+        copy->buffers[0] = createReadOnlyBuffer(sizeof(int) * entries, ellColumns.data());
+        copy->buffers[1] = createReadOnlyBuffer(sizeof(T) * entries, ellValues.data());
+        copy->buffers[2] = createReadOnlyBuffer(0, nullptr);
+    } else {
+        copy->buffers[0] = createReadOnlyBuffer(sizeof(int) * rowOffsets.size(), rowOffsets.data());
+        copy->buffers[1] = createReadOnlyBuffer(sizeof(int) * columnIndices.size(), columnIndices.data());
+        copy->buffers[2] = createReadOnlyBuffer(sizeof(T) * values.size(), values.data());
+    }
+
+    if (!copy->buffers[0] || !copy->buffers[1] || !copy->buffers[2]) {
+        std::cerr << "ERROR Creating buffers" << std::endl;
+        return nullptr;
+    }
+    device = copy;
+    return device.get();
+}
+
+namespace {
+
+// Enqueues C = S * B for the device copy of S; B and C are device buffers
+template <typename T, typename Acc, typename Copy>
+cl_int enqueueSparse(const Copy& copy, cl_mem bufferB, cl_mem bufferC, int rows, int cols, int strideB, int strideC) {
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    cl_kernel kernel = runtime.getKernel(sparseSource<T, Acc>(), copy.ell ? "ellMultiply" : "csrMultiply");
+    if (kernel == nullptr) {
+        return CL_BUILD_PROGRAM_FAILURE;
+    }
+
+    std::lock_guard<std::mutex> guard(runtime.lock());
+    int arg = 0;
+    if (copy.ell) {
+        clSetKernelArg(kernel, arg++, sizeof(cl_mem), &copy.buffers[0]);
+        clSetKernelArg(kernel, arg++, sizeof(cl_mem), &copy.buffers[1]);
+        clSetKernelArg(kernel, arg++, sizeof(int), &copy.ellWidth);
+    } else {
+        for (int i = 0; i < 3; ++i) {
+            clSetKernelArg(kernel, arg++, sizeof(cl_mem), &copy.buffers[i]);
+        }
+    }
+    clSetKernelArg(kernel, arg++, sizeof(cl_mem), &bufferB);
+    clSetKernelArg(kernel, arg++, sizeof(cl_mem), &bufferC);
+    clSetKernelArg(kernel, arg++, sizeof(int), &rows);
+    clSetKernelArg(kernel, arg++, sizeof(int), &cols);
+    clSetKernelArg(kernel, arg++, sizeof(int), &strideB);
+    clSetKernelArg(kernel, arg++, sizeof(int), &strideC);
+
+    size_t globalWorkSize[2] = {static_cast<size_t>(cols), static_cast<size_t>(rows)};
+    PHY250_COUNT(KernelLaunches, 1);
+    return clEnqueueNDRangeKernel(runtime.getQueue(), kernel, 2, nullptr, globalWorkSize, nullptr, 0, nullptr,
+                                  runtime.profileEvent(OpenCLRuntime::ProfileKernel));
+}
+
+} // namespace
+
+template <typename T>
+Matrix<typename SparseMatrix<T>::ResultType> SparseMatrix<T>::multiplyOpenCL(Matrix<T>& dense) const {
+    if (!OpenCLRuntime::instance().isAvailable() || cols != dense.rows) {
+        return Matrix<ResultType>();
+    }
+    if (!OpenCLElement<T>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<T>::name() << " matrices." << std::endl;
+        return Matrix<ResultType>();
+    }
+
+    Matrix<ResultType> result(rows, dense.cols);
+    if (rows == 0 || dense.cols == 0) {
+        return result;
+    }
+
+    const DeviceCopy* copy = getDeviceCopy();
+    dense.upload();
+    cl_mem bufferB = dense.deviceValid ? dense.deviceBuffer : nullptr;
+    cl_mem bufferC = result.getDeviceBuffer();
+    if (copy == nullptr || bufferB == nullptr || bufferC == nullptr) {
+        return Matrix<ResultType>();
+    }
+
+    cl_int error = enqueueSparse<T, ResultType>(*copy, bufferB, bufferC, rows, dense.cols, dense.stride, result.stride);
+    if (error != CL_SUCCESS) {
+        std::cerr << "ERROR Enqueueing kernel" << std::endl;
+        return Matrix<ResultType>();
+    }
+    clFlush(OpenCLRuntime::instance().getQueue());
+
+    dense.deviceBusy = true;
+    result.deviceBusy = true;
+    result.deviceValid = true;
+    result.hostValid = false;
+    return result;
+}
+
+template <typename T>
+std::vector<typename SparseMatrix<T>::ResultType> SparseMatrix<T>::multiplyOpenCL(const std::vector<T>& vector) const {
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    if (!runtime.isAvailable() || cols != static_cast<int>(vector.size())) {
+        return std::vector<ResultType>();
+    }
+    if (!OpenCLElement<T>::isSupported()) {
+        std::cerr << "Error: Device does not support " << OpenCLElement<T>::name() << " matrices." << std::endl;
+        return std::vector<ResultType>();
+    }
+
+    std::vector<ResultType> result(rows);
+    if (rows == 0) {
+        return result;
+    }
+
+    // x goes up and y comes back through one pinned staging buffer
+    const DeviceCopy* copy = getDeviceCopy();
+    BufferPool& pool = runtime.getBufferPool();
+    const size_t bytesX = sizeof(T) * vector.size();
+    const size_t bytesY = sizeof(ResultType) * rows;
+    StagingBuffer staging = pool.acquireStaging(std::max(bytesX, bytesY));
+    cl_mem bufferX = pool.acquire(bytesX);
+    cl_mem bufferY = pool.acquire(bytesY);
+    if (copy == nullptr || staging.buffer == nullptr || bufferX == nullptr || bufferY == nullptr) {
+        std::cerr << "ERROR Creating buffers" << std::endl;
+        pool.releaseStaging(staging);
+        pool.release(bufferX);
+        pool.release(bufferY);
+        return std::vector<ResultType>();
+    }
+
+    std::copy(vector.begin(), vector.end(), static_cast<T*>(staging.host));
+    cl_int error = CL_SUCCESS;
+    if (bytesX > 0) {
+        PHY250_COUNT(BytesWritten, bytesX);
+        error = clEnqueueWriteBuffer(runtime.getQueue(), bufferX, CL_FALSE, 0, bytesX, staging.host, 0, nullptr,
+                                     runtime.profileEvent(OpenCLRuntime::ProfileWrite));
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueSparse<T, ResultType>(*copy, bufferX, bufferY, rows, 1, 1, 1);
+    }
+    if (error == CL_SUCCESS) {
+        PHY250_COUNT(BytesRead, bytesY);
+        error = clEnqueueReadBuffer(runtime.getQueue(), bufferY, CL_TRUE, 0, bytesY, staging.host,
+                                    0, nullptr, runtime.profileEvent(OpenCLRuntime::ProfileRead));
+    }
+    if (error == CL_SUCCESS) {
+        const ResultType* y = static_cast<const ResultType*>(staging.host);
+        std::copy(y, y + rows, result.begin());
+    } else {
+        clFinish(runtime.getQueue());
+    }
+    pool.releaseStaging(staging);
+    pool.release(bufferX);
+    pool.release(bufferY);
+
+    if (error != CL_SUCCESS) {
+        std::cerr << "ERROR Reading result" << std::endl;
+        return std::vector<ResultType>();
+    }
+    return result;
+}
+
+template <typename T>
+Matrix<typename SparseMatrix<T>::ResultType> SparseMatrix<T>::multiply(Matrix<T>& dense, bool useOpenCL) const {
+    if (getDensity() < sparseDensityThreshold) {
+        return useOpenCL ? multiplyOpenCL(dense) : multiplyCPU(dense);
+    }
+    Matrix<T> full = toDense();
+    return useOpenCL ? full.multiplyOpenCL(dense) : full.multiplyCPU(dense);
+}
+
+template <typename T>
+void SparseMatrix<T>::print() const {
+    for (int r = 0; r < rows; ++r) {
+        for (int k = rowOffsets[r]; k < rowOffsets[r + 1]; ++k) {
+            // Unary plus prints int8_t as a number rather than a character
+            std::cout << r << " " << columnIndices[k] << " " << +values[k] << "\n";
+        }
+    }
+}
+
+template class SparseMatrix<float>;
+template class SparseMatrix<double>;
+template class SparseMatrix<int32_t>;
+template class SparseMatrix<int64_t>;
+template class SparseMatrix<int8_t>;
@@ -0,0 +1,88 @@
+// sparse_matrix.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef SPARSE_MATRIX_HPP
+#define SPARSE_MATRIX_HPP
+
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "matrix.hpp"
+
+// Sparse matrix in compressed sparse row (CSR) form: the nonzeros of row r
+// are values[rowOffsets[r] .. rowOffsets[r + 1]), in column order, with
+// their columns in columnIndices. Storage and multiply cost scale with the
+// number of nonzeros instead of rows * cols. Instantiated for the same
+// element types as Matrix.
+//
+// The OpenCL kernels read the matrix either as CSR or as ELL, where every
+// row is padded to the longest row and stored column-major so neighbouring
+// work-items read neighbouring addresses. ELL is used when the padding adds
+// little, as for stencils and banded operators.
+template <typename T>
+class SparseMatrix {
+public:
+    typedef typename Accumulator<T>::type ResultType;
+
+    // Constructors
+    SparseMatrix();
+    SparseMatrix(int rows, int cols, const std::vector<int>& rowOffsets, const std::vector<int>& columnIndices,
+                 const std::vector<T>& values);
+
+    // Builds the matrix from (row, col, value) entries in any order;
+    // duplicates are summed and zeros dropped
+    SparseMatrix(int rows, int cols, const std::vector<std::tuple<int, int, T>>& entries);
+
+    // Conversion to and from dense matrices
+    static SparseMatrix fromDense(const Matrix<T>& dense);
+    Matrix<T> toDense() const;
+
+    // Accessor methods
+    int getRows() const;
+    int getCols() const;
+    int getNonZeros() const;
+    double getDensity() const;
+    T getElement(int row, int col) const;
+
+    const std::vector<int>& getRowOffsets() const;
+    const std::vector<int>& getColumnIndices() const;
+    const std::vector<T>& getValues() const;
+
+    // Sparse x dense and sparse x vector products. The CPU versions run on
+    // the thread pool; the OpenCL result matrix stays on the device like
+    // Matrix::multiplyOpenCL's.
+    Matrix<ResultType> multiplyCPU(const Matrix<T>& dense) const;
+    std::vector<ResultType> multiplyCPU(const std::vector<T>& vector) const;
+    Matrix<ResultType> multiplyOpenCL(Matrix<T>& dense) const;
+    std::vector<ResultType> multiplyOpenCL(const std::vector<T>& vector) const;
+
+    // Picks the sparse kernels or a dense multiply by density
+    Matrix<ResultType> multiply(Matrix<T>& dense, bool useOpenCL = false) const;
+
+    // Print matrix
+    void print() const;
+
+private:
+    struct DeviceCopy;
+
+    int rows;
+    int cols;
+    std::vector<int> rowOffsets;
+    std::vector<int> columnIndices;
+    std::vector<T> values;
+
+    // Device buffers, built on first OpenCL use. The matrix never changes
+    // after construction, so copies share them.
+    mutable std::shared_ptr<DeviceCopy> device;
+
+    const DeviceCopy* getDeviceCopy() const;
+    bool usesEll() const;
+};
+
+// Below this density a sparse multiply beats the dense kernels
+const double sparseDensityThreshold = 0.05;
+
+#endif // SPARSE_MATRIX_HPP
@@ -0,0 +1,367 @@
+// strassen.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "strassen.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_async.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+// Elementwise passes below this many elements are not worth splitting up
+const int parallelElements = 1 << 16;
+
+// Temporaries are padded to whole cache lines
+const size_t arenaAlignment = 64;
+
+// Candidate CPU cutoffs, tried smallest first
+const int calibrationSizes[] = {256, 512, 1024};
+
+// One allocation carved up into the temporaries of every recursion level.
+// Levels run one after another, so each takes its blocks from the top and
+// gives them back on return.
+class ScratchArena {
+public:
+    explicit ScratchArena(size_t bytes) : base(nullptr), size(0), used(0) {
+        if (bytes > 0) {
+            base = static_cast<char*>(std::aligned_alloc(arenaAlignment, bytes));
+            size = base ? bytes : 0;
+        }
+    }
+
+    ~ScratchArena() {
+        std::free(base);
+    }
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    bool isValid() const {
+        return base != nullptr || size == 0;
+    }
+
+    template <typename T>
+    T* allocate(size_t count) {
+        size_t bytes = (count * sizeof(T) + arenaAlignment - 1) / arenaAlignment * arenaAlignment;
+        T* block = reinterpret_cast<T*>(base + used);
+        used += bytes;
+        return block;
+    }
+
+    size_t mark() const {
+        return used;
+    }
+
+    void release(size_t position) {
+        used = position;
+    }
+
+private:
+    char* base;
+    size_t size;
+    size_t used;
+};
+
+// Row stride of a temporary: whole cache lines, as in Matrix
+template <typename T>
+int paddedStride(int cols) {
+    const int alignment = arenaAlignment / sizeof(T);
+    return (cols + alignment - 1) / alignment * alignment;
+}
+
+template <typename T>
+size_t blockBytes(int rows, int cols) {
+    return sizeof(T) * static_cast<size_t>(rows) * paddedStride<T>(cols);
+}
+
+bool recurses(int rows, int inner, int cols, int cutoff) {
+    return std::min(rows, std::min(inner, cols)) >= std::max(cutoff, 2);
+}
+
+// Arena bytes needed by one product and everything below it
+template <typename T>
+size_t scratchBytes(int rows, int inner, int cols, int cutoff) {
+    size_t total = 0;
+    while (recurses(rows, inner, cols, cutoff)) {
+        rows /= 2;
+        inner /= 2;
+        cols /= 2;
+        total += blockBytes<T>(rows, inner) + blockBytes<T>(inner, cols) + blockBytes<T>(rows, cols);
+    }
+    return total;
+}
+
+// Z = X + Y, or Z = X - Y when subtract is set. Z may alias X or Y.
+template <typename T>
+void addBlocks(int rows, int cols, const T* X, int strideX, const T* Y, int strideY, T* Z, int strideZ, bool subtract) {
+    auto addRows = [=](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const T* x = X + static_cast<size_t>(i) * strideX;
+            const T* y = Y + static_cast<size_t>(i) * strideY;
+            T* z = Z + static_cast<size_t>(i) * strideZ;
+            if (subtract) {
+                for (int j = 0; j < cols; ++j) z[j] = x[j] - y[j];
+            } else {
+                for (int j = 0; j < cols; ++j) z[j] = x[j] + y[j];
+            }
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::instance();
+    if (static_cast<size_t>(rows) * cols < parallelElements || pool.getThreadCount() == 1) {
+        addRows(0, rows);
+        return;
+    }
+    int chunks = std::min(rows, pool.getThreadCount() * 4);
+    pool.parallelFor(chunks, [&](int chunk) {
+        addRows(static_cast<int>(static_cast<long long>(rows) * chunk / chunks),
+                static_cast<int>(static_cast<long long>(rows) * (chunk + 1) / chunks));
+    });
+}
+
+template <typename T>
+void baseMultiply(int rows, int inner, int cols, const T* A, int strideA, const T* B, int strideB, T* C, int strideC,
+                  bool useOpenCL) {
+    if (useOpenCL) {
+        AsyncGemm& async = AsyncGemm::instance();
+        cl_event done = async.submit<T, T>(rows, inner, cols, A, strideA, B, strideB, C, strideC);
+        if (done != nullptr) {
+            async.flush();
+            clWaitForEvents(1, &done);
+            clReleaseEvent(done);
+            return;
+        }
+        // The device could not take the block; the CPU result is the same.
+    }
+    gemmCPU(rows, inner, cols, A, strideA, B, strideB, C, strideC);
+}
+
+template <typename T>
+void strassen(int rows, int inner, int cols, const T* A, int strideA, const T* B, int strideB, T* C, int strideC,
+              bool useOpenCL, int cutoff, ScratchArena& arena) {
+    if (!recurses(rows, inner, cols, cutoff)) {
+        baseMultiply(rows, inner, cols, A, strideA, B, strideB, C, strideC, useOpenCL);
+        return;
+    }
+
+    const int mh = rows / 2;
+    const int kh = inner / 2;
+    const int nh = cols / 2;
+
+    const T* A11 = A;
+    const T* A12 = A + kh;
+    const T* A21 = A + static_cast<size_t>(mh) * strideA;
+    const T* A22 = A21 + kh;
+    const T* B11 = B;
+    const T* B12 = B + nh;
+    const T* B21 = B + static_cast<size_t>(kh) * strideB;
+    const T* B22 = B21 + nh;
+    T* C11 = C;
+    T* C12 = C + nh;
+    T* C21 = C + static_cast<size_t>(mh) * strideC;
+    T* C22 = C21 + nh;
+
+    size_t mark = arena.mark();
+    const int sx = paddedStride<T>(kh);
+    const int sy = paddedStride<T>(nh);
+    const int sz = paddedStride<T>(nh);
+    T* X = arena.allocate<T>(static_cast<size_t>(mh) * sx);
+    T* Y = arena.allocate<T>(static_cast<size_t>(kh) * sy);
+    T* Z = arena.allocate<T>(static_cast<size_t>(mh) * sz);
+
+    auto multiply = [&](const T* P, int strideP, const T* Q, int strideQ, T* R, int strideR) {
+        strassen(mh, kh, nh, P, strideP, Q, strideQ, R, strideR, useOpenCL, cutoff, arena);
+    };
+
+    // Winograd's variant with the products kept in the quadrants of C, so
+    // each level needs only X, Y and Z (Boyer, Dumas, Pernet and Zhou).
+    addBlocks(mh, kh, A11, strideA, A21, strideA, X, sx, true);         // S3 = A11 - A21
+    addBlocks(kh, nh, B22, strideB, B12, strideB, Y, sy, true);         // T3 = B22 - B12
+    multiply(X, sx, Y, sy, C21, strideC);                               // P7 = S3 T3
+    addBlocks(mh, kh, A21, strideA, A22, strideA, X, sx, false);        // S1 = A21 + A22
+    addBlocks(kh, nh, B12, strideB, B11, strideB, Y, sy, true);         // T1 = B12 - B11
+    multiply(X, sx, Y, sy, C22, strideC);                               // P5 = S1 T1
+    addBlocks(mh, kh, X, sx, A11, strideA, X, sx, true);                // S2 = S1 - A11
+    addBlocks(kh, nh, B22, strideB, Y, sy, Y, sy, true);                // T2 = B22 - T1
+    multiply(X, sx, Y, sy, C12, strideC);                               // P6 = S2 T2
+    addBlocks(mh, kh, A12, strideA, X, sx, X, sx, true);                // S4 = A12 - S2
+    multiply(X, sx, B22, strideB, C11, strideC);                        // P3 = S4 B22
+    multiply(A11, strideA, B11, strideB, Z, sz);                        // P1 = A11 B11
+    addBlocks(mh, nh, C12, strideC, Z, sz, C12, strideC, false);        // U2 = P1 + P6
+    addBlocks(mh, nh, C21, strideC, C12, strideC, C21, strideC, false); // U3 = U2 + P7
+    addBlocks(mh, nh, C12, strideC, C22, strideC, C12, strideC, false); // U4 = U2 + P5
+    addBlocks(mh, nh, C12, strideC, C11, strideC, C12, strideC, false); // C12 = U4 + P3
+    addBlocks(mh, nh, C22, strideC, C21, strideC, C22, strideC, false); // C22 = U3 + P5
+    addBlocks(kh, nh, Y, sy, B21, strideB, Y, sy, true);                // T4 = T2 - B21
+    multiply(A22, strideA, Y, sy, C11, strideC);                        // P4 = A22 T4
+    addBlocks(mh, nh, C21, strideC, C11, strideC, C21, strideC, true);  // C21 = U3 - P4
+    multiply(A12, strideA, B21, strideB, C11, strideC);                 // P2 = A12 B21
+    addBlocks(mh, nh, C11, strideC, Z, sz, C11, strideC, false);        // C11 = P1 + P2
+
+    arena.release(mark);
+
+    // Peel off what the even split left out. An odd inner index adds a
+    // rank-one update to the core; an odd row or column is a thin product.
+    const int m2 = 2 * mh;
+    const int k2 = 2 * kh;
+    const int n2 = 2 * nh;
+    if (k2 < inner) {
+        const T* b = B + static_cast<size_t>(k2) * strideB;
+        for (int i = 0; i < m2; ++i) {
+            T a = A[static_cast<size_t>(i) * strideA + k2];
+            T* c = C + static_cast<size_t>(i) * strideC;
+            for (int j = 0; j < n2; ++j) {
+                c[j] += a * b[j];
+            }
+        }
+    }
+    // These are matrix-vector products, done directly: gemmCPU would pad
+    // the single row or column out to a full register block.
+    if (n2 < cols) {
+        for (int i = 0; i < m2; ++i) {
+            const T* a = A + static_cast<size_t>(i) * strideA;
+            T sum = 0;
+            for (int p = 0; p < inner; ++p) {
+                sum += a[p] * B[static_cast<size_t>(p) * strideB + n2];
+            }
+            C[static_cast<size_t>(i) * strideC + n2] = sum;
+        }
+    }
+    if (m2 < rows) {
+        const T* a = A + static_cast<size_t>(m2) * strideA;
+        T* c = C + static_cast<size_t>(m2) * strideC;
+        std::fill_n(c, cols, T(0));
+        for (int p = 0; p < inner; ++p) {
+            const T* b = B + static_cast<size_t>(p) * strideB;
+            for (int j = 0; j < cols; ++j) {
+                c[j] += a[p] * b[j];
+            }
+        }
+    }
+}
+
+// Runs the recursion in Acc, widening narrower inputs into the arena first
+template <typename T, typename Acc>
+void strassenWidened(int rows, int inner, int cols, const T* A, int strideA, const T* B, int strideB, Acc* C, int strideC,
+                     bool useOpenCL, int cutoff) {
+    const bool widen = !std::is_same<T, Acc>::value;
+    size_t bytes = scratchBytes<Acc>(rows, inner, cols, cutoff);
+    if (widen) {
+        bytes += blockBytes<Acc>(rows, inner) + blockBytes<Acc>(inner, cols);
+    }
+
+    ScratchArena arena(bytes);
+    if (!arena.isValid()) {
+        std::cerr << "Error: Failed to allocate Strassen scratch space." << std::endl;
+        return;
+    }
+
+    const Acc* a = reinterpret_cast<const Acc*>(A);
+    const Acc* b = reinterpret_cast<const Acc*>(B);
+    if (widen) {
+        int wideA = paddedStride<Acc>(inner);
+        int wideB = paddedStride<Acc>(cols);
+        Acc* copyA = arena.allocate<Acc>(static_cast<size_t>(rows) * wideA);
+        Acc* copyB = arena.allocate<Acc>(static_cast<size_t>(inner) * wideB);
+        for (int i = 0; i < rows; ++i) {
+            std::copy_n(A + static_cast<size_t>(i) * strideA, inner, copyA + static_cast<size_t>(i) * wideA);
+        }
+        for (int i = 0; i < inner; ++i) {
+            std::copy_n(B + static_cast<size_t>(i) * strideB, cols, copyB + static_cast<size_t>(i) * wideB);
+        }
+        a = copyA;
+        b = copyB;
+        strideA = wideA;
+        strideB = wideB;
+    }
+
+    strassen<Acc>(rows, inner, cols, a, strideA, b, strideB, C, strideC, useOpenCL, cutoff, arena);
+}
+
+double secondsFor(const std::function<void()>& run) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Smallest size at which one Strassen level over gemmCPU beats gemmCPU alone
+int calibrateCPUCutoff() {
+    for (int size : calibrationSizes) {
+        std::vector<int> A(static_cast<size_t>(size) * size, 1);
+        std::vector<int> B(A.size(), 1);
+        std::vector<int> C(A.size());
+
+        // Best of three runs of each, after one untimed warm-up
+        gemmCPU(size, size, size, A.data(), size, B.data(), size, C.data(), size);
+        double direct = 1e30;
+        double recursive = 1e30;
+        for (int repeat = 0; repeat < 3; ++repeat) {
+            direct = std::min(direct, secondsFor([&] {
+                gemmCPU(size, size, size, A.data(), size, B.data(), size, C.data(), size);
+            }));
+            recursive = std::min(recursive, secondsFor([&] {
+                strassenWidened<int, int>(size, size, size, A.data(), size, B.data(), size, C.data(), size, false, size);
+            }));
+        }
+        // A level saves at most an eighth, so ask for a clear win rather
+        // than one that timing noise could produce
+        if (recursive < 0.95 * direct) {
+            return size;
+        }
+    }
+    return 2 * calibrationSizes[sizeof(calibrationSizes) / sizeof(calibrationSizes[0]) - 1];
+}
+
+} // namespace
+
+int strassenCutoff(bool useOpenCL) {
+    const char* setting = std::getenv("PHY250_STRASSEN_CUTOFF");
+    if (setting != nullptr && std::atoi(setting) > 0) {
+        return std::atoi(setting);
+    }
+    // Device leaves pay a transfer and a wait each, so they must be large
+    if (useOpenCL) {
+        return 1024;
+    }
+    static const int cutoff = calibrateCPUCutoff();
+    return cutoff;
+}
+
+template <typename T, typename Acc>
+void gemmStrassen(int rows, int inner, int cols,
+                  const T* A, int strideA,
+                  const T* B, int strideB,
+                  Acc* C, int strideC,
+                  bool useOpenCL, int cutoff) {
+    if (rows <= 0 || cols <= 0) {
+        return;
+    }
+    PHY250_TIME_SCOPE("gemmStrassen");
+    if (cutoff <= 0) {
+        cutoff = strassenCutoff(useOpenCL);
+    }
+    if (!recurses(rows, inner, cols, cutoff) && !useOpenCL) {
+        gemmCPU(rows, inner, cols, A, strideA, B, strideB, C, strideC);
+        return;
+    }
+    strassenWidened(rows, inner, cols, A, strideA, B, strideB, C, strideC, useOpenCL, cutoff);
+}
+
+template void gemmStrassen<float, float>(int, int, int, const float*, int, const float*, int, float*, int, bool, int);
+template void gemmStrassen<double, double>(int, int, int, const double*, int, const double*, int, double*, int, bool, int);
+template void gemmStrassen<int32_t, int32_t>(int, int, int, const int32_t*, int, const int32_t*, int, int32_t*, int, bool, int);
+template void gemmStrassen<int64_t, int64_t>(int, int, int, const int64_t*, int, const int64_t*, int, int64_t*, int, bool, int);
+template void gemmStrassen<int8_t, int32_t>(int, int, int, const int8_t*, int, const int8_t*, int, int32_t*, int, bool, int);
@@ -0,0 +1,33 @@
+// strassen.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+// C = A * B by Strassen-Winograd, with the same layout as gemmCPU: A is
+// rows x inner, B is inner x cols and C is rows x cols, row-major with the
+// given row strides in elements.
+//
+// Each level splits the even part of every dimension in half and does 7
+// half-size multiplies instead of 8; odd rows, columns and inner indices are
+// peeled off and handled as thin products. Blocks with a dimension below
+// cutoff go to the base kernel: gemmCPU, or the OpenCL device when useOpenCL
+// is set. All temporaries come from one scratch arena sized up front.
+//
+// int8_t inputs are widened to int32_t first, since the block sums and
+// differences do not fit in 8 bits.
+template <typename T, typename Acc>
+void gemmStrassen(int rows, int inner, int cols,
+                  const T* A, int strideA,
+                  const T* B, int strideB,
+                  Acc* C, int strideC,
+                  bool useOpenCL, int cutoff);
+
+// Default cutoff for a base kernel. PHY250_STRASSEN_CUTOFF overrides it;
+// otherwise the CPU cutoff is measured once per process as the smallest
+// size at which one Strassen level beats the plain kernel.
+int strassenCutoff(bool useOpenCL);
+
+#endif // STRASSEN_HPP
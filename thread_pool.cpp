@@ -0,0 +1,183 @@
+// thread_pool.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+// Index of the current thread's queue in the pool it works for, or -1 for
+// threads outside any pool.
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local int currentQueue = -1;
+
+int defaultThreadCount() {
+    const char* setting = std::getenv("PHY250_NUM_THREADS");
+    if (setting != nullptr && std::atoi(setting) > 0) {
+        return std::atoi(setting);
+    }
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+} // namespace
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(defaultThreadCount());
+    return pool;
+}
+
+ThreadPool::ThreadPool(int threads) : threadCount(0), queued(0), stopping(false), nextQueue(0) {
+    start(threads);
+}
+
+ThreadPool::~ThreadPool() {
+    stop();
+}
+
+void ThreadPool::setThreadCount(int threads) {
+    if (threads == threadCount) {
+        return;
+    }
+    stop();
+    start(threads);
+}
+
+int ThreadPool::getThreadCount() const {
+    return threadCount;
+}
+
+void ThreadPool::start(int threads) {
+    threadCount = std::max(1, threads);
+    stopping = false;
+
+    // One queue per worker plus one shared by outside callers.
+    queues.clear();
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::unique_ptr<Queue>(new Queue));
+    }
+    for (int i = 0; i + 1 < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+void ThreadPool::stop() {
+    {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+}
+
+void ThreadPool::workerLoop(int index) {
+    currentPool = this;
+    currentQueue = index;
+
+    Job job;
+    while (true) {
+        if (takeJob(index, job)) {
+            runJob(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::takeJob(int index, Job& job) {
+    // Own work first, newest first, while it is still hot in cache.
+    {
+        Queue& own = *queues[index];
+        std::lock_guard<std::mutex> guard(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            --queued;
+            return true;
+        }
+    }
+
+    // Then steal the oldest work from everyone else.
+    int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset < count; ++offset) {
+        Queue& victim = *queues[(index + offset) % count];
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            --queued;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::runJob(const Job& job) {
+    for (int i = job.begin; i < job.end; ++i) {
+        (*job.batch->body)(i);
+    }
+
+    // The decrement happens under the batch mutex so the waiting caller
+    // cannot return and destroy the batch while it is still being notified.
+    int finished = job.end - job.begin;
+    std::lock_guard<std::mutex> guard(job.batch->mutex);
+    if (job.batch->remaining.fetch_sub(finished) == finished) {
+        job.batch->done.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& body) {
+    if (count <= 0) {
+        return;
+    }
+    if (threadCount == 1 || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    Batch batch;
+    batch.body = &body;
+    batch.remaining = count;
+
+    // A few jobs per thread leaves room to rebalance by stealing without
+    // paying a queue operation per index.
+    int chunk = std::max(1, count / (threadCount * 4));
+    int home = currentPool == this ? currentQueue : static_cast<int>(queues.size()) - 1;
+    int jobs = 0;
+    for (int begin = 0; begin < count; begin += chunk, ++jobs) {
+        Job job = {&batch, begin, std::min(count, begin + chunk)};
+        // Spread the initial jobs over all queues so every worker starts
+        // with local work; stealing evens out the rest.
+        int target = currentPool == this ? home : static_cast<int>(nextQueue++ % queues.size());
+        Queue& queue = *queues[target];
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+        queued += jobs;
+    }
+    wake.notify_all();
+
+    // Help out until this batch is done, then wait for the stragglers.
+    Job job;
+    while (batch.remaining.load() > 0 && takeJob(home, job)) {
+        runJob(job);
+    }
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&batch] { return batch.remaining.load() == 0; });
+}
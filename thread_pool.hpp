@@ -0,0 +1,78 @@
+// thread_pool.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent work-stealing pool. Each worker owns a deque: it pops its own
+// work from the back and steals from the front of the others when it runs
+// dry. The thread calling parallelFor works too, so a pool of size n runs
+// n - 1 worker threads. Threads are started once and reused by every call.
+class ThreadPool {
+public:
+    // Shared pool, sized from PHY250_NUM_THREADS or the hardware thread count
+    static ThreadPool& instance();
+
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Restarts the pool with a new size. Must not be called while a
+    // parallelFor is running.
+    void setThreadCount(int threads);
+    int getThreadCount() const;
+
+    // Calls body(i) for every i in [0, count) and returns once all calls
+    // have finished. May be called from inside a body.
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+private:
+    struct Batch {
+        const std::function<void(int)>* body;
+        std::atomic<int> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    struct Job {
+        Batch* batch;
+        int begin;
+        int end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void start(int threads);
+    void stop();
+    void workerLoop(int index);
+    bool takeJob(int index, Job& job);
+    void runJob(const Job& job);
+
+    int threadCount;
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::atomic<int> queued;
+    bool stopping;
+    std::atomic<unsigned> nextQueue;
+};
+
+#endif // THREAD_POOL_HPP
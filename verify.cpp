@@ -0,0 +1,502 @@
+// verify.cpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#include "verify.hpp"
+#include "buffer_pool.hpp"
+#include "cpu_gemm.hpp"
+#include "instrumentation.hpp"
+#include "opencl_gemm.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+// out = M * v for every trial at once: work-item (t, row) takes the dot
+// product of one row of M with vector t. v holds the trials' values for
+// each column together. Without EXACT, outMagnitude is computed alongside
+// for the tolerance as in MagnitudeMode.
+const char* freivaldsKernelBody = R"(
+    __kernel void freivaldsMultiply(__global const TYPE* M,
+                                    const int stride,
+                                    const int rows,
+                                    const int cols,
+                                    __global const WORD* v,
+                                    __global const WORD* vMagnitude,
+                                    __global WORD* out,
+                                    __global WORD* outMagnitude,
+                                    const int trials,
+                                    const int mode) {
+        const int t = get_global_id(0);
+        const int row = get_global_id(1);
+        if (t >= trials || row >= rows) {
+            return;
+        }
+
+        __global const TYPE* values = M + (long)row * stride;
+        WORD sum = 0;
+        #ifndef EXACT
+        WORD magnitude = 0;
+        #endif
+        for (int j = 0; j < cols; ++j) {
+            const WORD value = (WORD)values[j];
+            sum += value * v[j * trials + t];
+            #ifndef EXACT
+            const WORD scale = vMagnitude[j * trials + t];
+            const WORD term = fabs(value) * scale;
+            magnitude += mode == 0 ? term : (mode == 1 ? term * term : value * value * scale);
+            #endif
+        }
+        out[row * trials + t] = sum;
+        #ifndef EXACT
+        outMagnitude[row * trials + t] = magnitude;
+        #endif
+    }
+)";
+
+// What outMagnitude sums for each row of M: |M| vMagnitude, the squares of
+// those terms, or M^2 vMagnitude for a vMagnitude that is already squared
+enum MagnitudeMode { MagnitudeSum, MagnitudeSquares, MagnitudeSquaredRows };
+
+// Products of more multiply-adds than this are split over the thread pool
+const double parallelWork = 1 << 18;
+
+// Floating-point tolerance in multiples of the rounding error estimated in
+// compareRows. Correct products of signed, positive, skewed and cancelling
+// inputs stay below a quarter of it with every CPU kernel and a naive
+// sequential sum.
+const double verifyTolerance = 4.0;
+
+// Arithmetic for checking an Acc product. Integers use unsigned words of
+// the same width, so sums wrap exactly as the multiply's do. Floats are
+// summed in double on the host; devices may lack double, so they use Acc.
+template <typename Acc>
+struct CheckWord;
+
+template <>
+struct CheckWord<float> {
+    typedef double Host;
+    typedef float Device;
+};
+
+template <>
+struct CheckWord<double> {
+    typedef double Host;
+    typedef double Device;
+};
+
+template <>
+struct CheckWord<int32_t> {
+    typedef uint32_t Host;
+    typedef uint32_t Device;
+};
+
+template <>
+struct CheckWord<int64_t> {
+    typedef uint64_t Host;
+    typedef uint64_t Device;
+};
+
+template <typename W>
+const char* wordName();
+
+template <>
+const char* wordName<float>() {
+    return "float";
+}
+
+template <>
+const char* wordName<double>() {
+    return "double";
+}
+
+template <>
+const char* wordName<uint32_t>() {
+    return "uint";
+}
+
+template <>
+const char* wordName<uint64_t>() {
+    return "ulong";
+}
+
+// Program for checks against E matrices, e.g. the int8 operands or the
+// int32 product of an int8 multiply
+template <typename E, typename Acc>
+const std::string& freivaldsSource() {
+    static const std::string source = openCLTypeDefines<E, Acc>() + "#define WORD " +
+                                      wordName<typename CheckWord<Acc>::Device>() + "\n" +
+                                      (std::is_integral<Acc>::value ? "#define EXACT\n" : "") + freivaldsKernelBody;
+    return source;
+}
+
+// Seeded once per thread from the system, so no fixed vector can be
+// relied on to slip a wrong result through
+std::mt19937_64& generator() {
+    thread_local std::mt19937_64 engine(std::random_device{}());
+    return engine;
+}
+
+// trials random values for each of length rows. Integers use every bit of
+// the word. Floats get random signs and magnitudes in [0.5, 1), so no entry
+// is close enough to zero to hide an error in its column.
+template <typename W>
+void randomVectors(int length, int trials, std::vector<W>& v, std::vector<W>& magnitude) {
+    v.resize(static_cast<size_t>(length) * trials);
+    magnitude.resize(v.size());
+    std::mt19937_64& engine = generator();
+    for (size_t i = 0; i < v.size(); ++i) {
+        if constexpr (std::is_integral<W>::value) {
+            v[i] = static_cast<W>(engine());
+        } else {
+            std::uniform_real_distribution<double> distribution(0.5, 1.0);
+            magnitude[i] = static_cast<W>(distribution(engine));
+            v[i] = (engine() & 1) ? magnitude[i] : -magnitude[i];
+        }
+    }
+}
+
+// out = M * v for trials vectors at once, where M is rows x cols and v
+// holds the trials' values for each column together. For floating point,
+// outMagnitude is computed alongside as in mode.
+template <typename E, typename W>
+void multiplyVectors(int rows, int cols, const E* M, int stride, const W* v, const W* vMagnitude,
+                     W* out, W* outMagnitude, int trials, MagnitudeMode mode) {
+    auto multiplyRows = [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+            const E* values = M + static_cast<size_t>(i) * stride;
+            W* sum = out + static_cast<size_t>(i) * trials;
+            std::fill(sum, sum + trials, W(0));
+            for (int j = 0; j < cols; ++j) {
+                const W value = static_cast<W>(values[j]);
+                const W* vector = v + static_cast<size_t>(j) * trials;
+                for (int t = 0; t < trials; ++t) {
+                    sum[t] += value * vector[t];
+                }
+            }
+
+            if constexpr (!std::is_integral<W>::value) {
+                W* magnitude = outMagnitude + static_cast<size_t>(i) * trials;
+                std::fill(magnitude, magnitude + trials, W(0));
+                for (int j = 0; j < cols; ++j) {
+                    const W value = std::fabs(static_cast<W>(values[j]));
+                    const W* vector = vMagnitude + static_cast<size_t>(j) * trials;
+                    for (int t = 0; t < trials; ++t) {
+                        const W term = value * vector[t];
+                        if (mode == MagnitudeSum) {
+                            magnitude[t] += term;
+                        } else if (mode == MagnitudeSquares) {
+                            magnitude[t] += term * term;
+                        } else {
+                            magnitude[t] += value * term;
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    ThreadPool& pool = ThreadPool::instance();
+    if (pool.getThreadCount() == 1 || static_cast<double>(rows) * cols * trials < parallelWork) {
+        multiplyRows(0, rows);
+        return;
+    }
+    int chunks = std::min(rows, pool.getThreadCount() * 4);
+    pool.parallelFor(chunks, [&](int chunk) {
+        int begin = static_cast<int>(static_cast<long long>(rows) * chunk / chunks);
+        int end = static_cast<int>(static_cast<long long>(rows) * (chunk + 1) / chunks);
+        multiplyRows(begin, end);
+    });
+}
+
+// Rows where A * (B * r) and C * r disagree in any trial; see verify.hpp for
+// the floating-point tolerance. expectedMagnitude is |A| |B| |r| with
+// normwise and A^2 B^2 r^2 without, and actualSquares the sum of the
+// squared terms of C * r.
+template <typename Acc, typename W>
+std::vector<int> compareRows(int rows, int inner, int cols, int trials, bool normwise, const W* expected,
+                             const W* expectedMagnitude, const W* actual, const W* actualSquares) {
+    std::vector<int> mismatched;
+    if constexpr (std::is_integral<W>::value) {
+        for (int i = 0; i < rows; ++i) {
+            const size_t first = static_cast<size_t>(i) * trials;
+            if (!std::equal(expected + first, expected + first + trials, actual + first)) {
+                mismatched.push_back(i);
+            }
+        }
+    } else {
+        const double product = std::numeric_limits<Acc>::epsilon() * std::sqrt(static_cast<double>(inner));
+        const double check = std::numeric_limits<W>::epsilon() * std::sqrt(static_cast<double>(inner) + cols);
+        std::vector<double> largest(trials, 0.0);
+        if (normwise) {
+            for (size_t e = 0; e < static_cast<size_t>(rows) * trials; ++e) {
+                double magnitude = static_cast<double>(expectedMagnitude[e]);
+                if (std::isfinite(magnitude)) {
+                    largest[e % trials] = std::max(largest[e % trials], magnitude);
+                }
+            }
+        }
+
+        for (int i = 0; i < rows; ++i) {
+            for (int t = 0; t < trials; ++t) {
+                const size_t e = static_cast<size_t>(i) * trials + t;
+                double scale = largest[t];
+                if (!normwise) {
+                    scale = std::sqrt(static_cast<double>(expectedMagnitude[e])) +
+                            std::sqrt(static_cast<double>(actualSquares[e]));
+                }
+                const double tolerance = verifyTolerance * (product + check) * scale;
+                double difference = std::fabs(static_cast<double>(expected[e]) - static_cast<double>(actual[e]));
+                if (!std::isfinite(difference) || !std::isfinite(tolerance) || !(difference <= tolerance)) {
+                    mismatched.push_back(i);
+                    break;
+                }
+            }
+        }
+    }
+    return mismatched;
+}
+
+// Enqueues out = M * v on the device, as multiplyVectors does on the host
+template <typename E, typename Acc>
+cl_int enqueueMultiplyVectors(OpenCLRuntime& runtime, int rows, int cols, cl_mem M, int stride, cl_mem v,
+                              cl_mem vMagnitude, cl_mem out, cl_mem outMagnitude, int trials, MagnitudeMode mode) {
+    cl_kernel kernel = runtime.getKernel(freivaldsSource<E, Acc>(), "freivaldsMultiply");
+    if (kernel == nullptr) {
+        return CL_BUILD_PROGRAM_FAILURE;
+    }
+
+    std::lock_guard<std::mutex> guard(runtime.lock());
+    clSetKernelArg(kernel, 0, sizeof(cl_mem), &M);
+    clSetKernelArg(kernel, 1, sizeof(int), &stride);
+    clSetKernelArg(kernel, 2, sizeof(int), &rows);
+    clSetKernelArg(kernel, 3, sizeof(int), &cols);
+    clSetKernelArg(kernel, 4, sizeof(cl_mem), &v);
+    clSetKernelArg(kernel, 5, sizeof(cl_mem), &vMagnitude);
+    clSetKernelArg(kernel, 6, sizeof(cl_mem), &out);
+    clSetKernelArg(kernel, 7, sizeof(cl_mem), &outMagnitude);
+    clSetKernelArg(kernel, 8, sizeof(int), &trials);
+    const int modeArg = mode;
+    clSetKernelArg(kernel, 9, sizeof(int), &modeArg);
+
+    size_t globalWorkSize[2] = {static_cast<size_t>(trials), static_cast<size_t>(rows)};
+    PHY250_COUNT(KernelLaunches, 1);
+    return clEnqueueNDRangeKernel(runtime.getQueue(), kernel, 2, nullptr, globalWorkSize, nullptr, 0, nullptr,
+                                  runtime.profileEvent(OpenCLRuntime::ProfileKernel));
+}
+
+} // namespace
+
+int verifyTrialsFromEnvironment() {
+    const char* setting = std::getenv("PHY250_VERIFY");
+    if (setting == nullptr || *setting == '\0') {
+        return 0;
+    }
+    return std::max(0, std::atoi(setting));
+}
+
+template <typename T, typename Acc>
+void repairRows(const char* method, const std::vector<int>& failed, int inner, int cols,
+                const T* A, int strideA,
+                const T* B, int strideB,
+                Acc* C, int strideC) {
+    std::cerr << "Error: " << method << " result failed verification in " << failed.size() << " rows (";
+    for (size_t i = 0; i < failed.size() && i < 8; ++i) {
+        std::cerr << (i > 0 ? " " : "") << failed[i];
+    }
+    std::cerr << (failed.size() > 8 ? " ...)" : ")") << "; recomputing them on the CPU." << std::endl;
+
+    for (int r : failed) {
+        gemmCPU(1, inner, cols, A + static_cast<size_t>(r) * strideA, strideA, B, strideB,
+                C + static_cast<size_t>(r) * strideC, strideC);
+    }
+}
+
+template <typename T, typename Acc>
+std::vector<int> verifyGemmCPU(int rows, int inner, int cols,
+                               const T* A, int strideA,
+                               const T* B, int strideB,
+                               const Acc* C, int strideC,
+                               int trials, bool normwise) {
+    if (rows <= 0 || cols <= 0) {
+        return std::vector<int>();
+    }
+    if (trials <= 0) {
+        trials = defaultVerifyTrials;
+    }
+
+    PHY250_TIME_SCOPE("verifyGemmCPU");
+    typedef typename CheckWord<Acc>::Host W;
+    std::vector<W> v, vMagnitude;
+    randomVectors(cols, trials, v, vMagnitude);
+
+    // x = B * r, then A * x against C * r
+    std::vector<W> x(static_cast<size_t>(inner) * trials), xMagnitude(x.size());
+    std::vector<W> expected(static_cast<size_t>(rows) * trials), expectedMagnitude(expected.size());
+    std::vector<W> actual(expected.size()), actualSquares(expected.size());
+    multiplyVectors(inner, cols, B, strideB, v.data(), vMagnitude.data(), x.data(), xMagnitude.data(), trials,
+                    normwise ? MagnitudeSum : MagnitudeSquares);
+    multiplyVectors(rows, inner, A, strideA, x.data(), xMagnitude.data(), expected.data(), expectedMagnitude.data(),
+                    trials, normwise ? MagnitudeSum : MagnitudeSquaredRows);
+    multiplyVectors(rows, cols, C, strideC, v.data(), vMagnitude.data(), actual.data(), actualSquares.data(), trials,
+                    MagnitudeSquares);
+
+    return compareRows<Acc>(rows, inner, cols, trials, normwise, expected.data(), expectedMagnitude.data(),
+                            actual.data(), actualSquares.data());
+}
+
+template <typename T, typename Acc>
+bool verifyGemmOpenCL(int rows, int inner, int cols,
+                      cl_mem bufferA, int strideA,
+                      cl_mem bufferB, int strideB,
+                      cl_mem bufferC, int strideC,
+                      int trials, bool normwise, std::vector<int>& mismatchedRows) {
+    if (rows <= 0 || cols <= 0) {
+        mismatchedRows.clear();
+        return true;
+    }
+    if (trials <= 0) {
+        trials = defaultVerifyTrials;
+    }
+
+    OpenCLRuntime& runtime = OpenCLRuntime::instance();
+    if (inner <= 0 || !runtime.isAvailable() || !OpenCLElement<T>::isSupported() ||
+        !OpenCLElement<Acc>::isSupported()) {
+        return false;
+    }
+
+    PHY250_TIME_SCOPE("verifyGemmOpenCL");
+    typedef typename CheckWord<Acc>::Device W;
+    const bool exact = std::is_integral<Acc>::value;
+    std::vector<W> v, vMagnitude;
+    randomVectors(cols, trials, v, vMagnitude);
+
+    // Pairs of value and magnitude buffers for r, B * r, A * B * r and
+    // C * r. Exact checks have no magnitudes and pass the value buffer
+    // twice; the kernel never touches it.
+    const size_t lengths[4] = {static_cast<size_t>(cols), static_cast<size_t>(inner), static_cast<size_t>(rows),
+                               static_cast<size_t>(rows)};
+    BufferPool& pool = runtime.getBufferPool();
+    cl_mem buffers[8] = {};
+    bool allocated = true;
+    for (int b = 0; b < 8; ++b) {
+        if (exact && b % 2 == 1) {
+            buffers[b] = buffers[b - 1];
+            continue;
+        }
+        buffers[b] = pool.acquire(sizeof(W) * lengths[b / 2] * trials);
+        allocated = allocated && buffers[b] != nullptr;
+    }
+
+    cl_command_queue queue = runtime.getQueue();
+    const size_t vectorBytes = sizeof(W) * v.size();
+    const size_t resultBytes = sizeof(W) * rows * static_cast<size_t>(trials);
+    std::vector<W> expected(static_cast<size_t>(rows) * trials), expectedMagnitude(expected.size());
+    std::vector<W> actual(expected.size()), actualSquares(expected.size());
+    cl_int error = allocated ? CL_SUCCESS : CL_MEM_OBJECT_ALLOCATION_FAILURE;
+    if (error == CL_SUCCESS) {
+        PHY250_COUNT(BytesWritten, exact ? vectorBytes : 2 * vectorBytes);
+        error = clEnqueueWriteBuffer(queue, buffers[0], CL_FALSE, 0, vectorBytes, v.data(), 0, nullptr,
+                                     runtime.profileEvent(OpenCLRuntime::ProfileWrite));
+    }
+    if (error == CL_SUCCESS && !exact) {
+        error = clEnqueueWriteBuffer(queue, buffers[1], CL_FALSE, 0, vectorBytes, vMagnitude.data(), 0, nullptr,
+                                     runtime.profileEvent(OpenCLRuntime::ProfileWrite));
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueMultiplyVectors<T, Acc>(runtime, inner, cols, bufferB, strideB, buffers[0], buffers[1],
+                                               buffers[2], buffers[3], trials,
+                                               normwise ? MagnitudeSum : MagnitudeSquares);
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueMultiplyVectors<T, Acc>(runtime, rows, inner, bufferA, strideA, buffers[2], buffers[3],
+                                               buffers[4], buffers[5], trials,
+                                               normwise ? MagnitudeSum : MagnitudeSquaredRows);
+    }
+    if (error == CL_SUCCESS) {
+        error = enqueueMultiplyVectors<Acc, Acc>(runtime, rows, cols, bufferC, strideC, buffers[0], buffers[1],
+                                                 buffers[6], buffers[7], trials, MagnitudeSquares);
+    }
+
+    // The queue is in order, so the blocking reads also wait for the writes
+    // of v above, which must not outlive it
+    if (error == CL_SUCCESS) {
+        PHY250_COUNT(BytesRead, exact ? 2 * resultBytes : 4 * resultBytes);
+        error = clEnqueueReadBuffer(queue, buffers[4], CL_FALSE, 0, resultBytes, expected.data(), 0, nullptr,
+                                    runtime.profileEvent(OpenCLRuntime::ProfileRead));
+    }
+    if (error == CL_SUCCESS && !exact) {
+        error = clEnqueueReadBuffer(queue, buffers[5], CL_FALSE, 0, resultBytes, expectedMagnitude.data(), 0,
+                                    nullptr, runtime.profileEvent(OpenCLRuntime::ProfileRead));
+    }
+    if (error == CL_SUCCESS && !exact) {
+        error = clEnqueueReadBuffer(queue, buffers[7], CL_FALSE, 0, resultBytes, actualSquares.data(), 0,
+                                    nullptr, runtime.profileEvent(OpenCLRuntime::ProfileRead));
+    }
+    if (error == CL_SUCCESS) {
+        error = clEnqueueReadBuffer(queue, buffers[6], CL_TRUE, 0, resultBytes, actual.data(), 0, nullptr,
+                                    runtime.profileEvent(OpenCLRuntime::ProfileRead));
+    }
+    if (error != CL_SUCCESS) {
+        // Nothing may still be reading or writing the buffers or vectors
+        clFinish(queue);
+    }
+
+    for (int b = 0; b < 8; ++b) {
+        if (!(exact && b % 2 == 1)) {
+            pool.release(buffers[b]);
+        }
+    }
+    if (error != CL_SUCCESS) {
+        std::cerr << "Error: Verification failed to run on the device." << std::endl;
+        return false;
+    }
+
+    mismatchedRows = compareRows<Acc>(rows, inner, cols, trials, normwise, expected.data(), expectedMagnitude.data(),
+                                      actual.data(), actualSquares.data());
+    return true;
+}
+
+template void repairRows<float, float>(const char*, const std::vector<int>&, int, int, const float*, int,
+                                       const float*, int, float*, int);
+template void repairRows<double, double>(const char*, const std::vector<int>&, int, int, const double*, int,
+                                         const double*, int, double*, int);
+template void repairRows<int32_t, int32_t>(const char*, const std::vector<int>&, int, int, const int32_t*, int,
+                                           const int32_t*, int, int32_t*, int);
+template void repairRows<int64_t, int64_t>(const char*, const std::vector<int>&, int, int, const int64_t*, int,
+                                           const int64_t*, int, int64_t*, int);
+template void repairRows<int8_t, int32_t>(const char*, const std::vector<int>&, int, int, const int8_t*, int,
+                                          const int8_t*, int, int32_t*, int);
+
+template std::vector<int> verifyGemmCPU<float, float>(int, int, int, const float*, int, const float*, int,
+                                                      const float*, int, int, bool);
+template std::vector<int> verifyGemmCPU<double, double>(int, int, int, const double*, int, const double*, int,
+                                                        const double*, int, int, bool);
+template std::vector<int> verifyGemmCPU<int32_t, int32_t>(int, int, int, const int32_t*, int, const int32_t*, int,
+                                                          const int32_t*, int, int, bool);
+template std::vector<int> verifyGemmCPU<int64_t, int64_t>(int, int, int, const int64_t*, int, const int64_t*, int,
+                                                          const int64_t*, int, int, bool);
+template std::vector<int> verifyGemmCPU<int8_t, int32_t>(int, int, int, const int8_t*, int, const int8_t*, int,
+                                                         const int32_t*, int, int, bool);
+
+template bool verifyGemmOpenCL<float, float>(int, int, int, cl_mem, int, cl_mem, int, cl_mem, int, int, bool,
+                                             std::vector<int>&);
+template bool verifyGemmOpenCL<double, double>(int, int, int, cl_mem, int, cl_mem, int, cl_mem, int, int, bool,
+                                               std::vector<int>&);
+template bool verifyGemmOpenCL<int32_t, int32_t>(int, int, int, cl_mem, int, cl_mem, int, cl_mem, int, int, bool,
+                                                 std::vector<int>&);
+template bool verifyGemmOpenCL<int64_t, int64_t>(int, int, int, cl_mem, int, cl_mem, int, cl_mem, int, int, bool,
+                                                 std::vector<int>&);
+template bool verifyGemmOpenCL<int8_t, int32_t>(int, int, int, cl_mem, int, cl_mem, int, cl_mem, int, int, bool,
+                                                std::vector<int>&);
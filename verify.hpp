@@ -0,0 +1,89 @@
+// verify.hpp
+// Gobind Kapoor, Jovin Louie
+// 2023-03-13
+//
+
+#ifndef VERIFY_HPP
+#define VERIFY_HPP
+
+#include <vector>
+
+#include "opencl_runtime.hpp"
+
+// Freivalds' check that C == A * B without multiplying again. Each trial
+// draws a random vector r and compares A * (B * r) with C * r, which takes
+// three matrix-vector products, so k trials cost O(k * n^2) instead of the
+// O(n^3) of a second multiply. The trials run together, reading each matrix
+// once.
+//
+// A wrong row passes a trial with probability at most 1/2, and far less for
+// anything but a carefully cancelling error, so a few trials are plenty.
+//
+// Integer products are checked exactly, with the same wraparound as the
+// multiply. Floating-point rounding errors add up like a random walk, so
+// each row gets a tolerance from its own magnitudes, a few times above
+// them but far below the worst-case bound, which would hide real errors.
+// An element of C is off by about sqrt(inner) * epsilon of Acc times the
+// larger of |C| and the root sum of squares of its terms a_ik b_kj; signed
+// data cancels down to the latter, positive data grows to the former. Over
+// a row of C * r these add up as root sums of squares: that of the terms
+// of C * r, and sqrt(A^2 B^2 r^2), which the passes over A and B sum
+// alongside. The check's own rounding, sqrt(inner + cols) * epsilon of the words
+// it sums in, scales the same way. Rows holding Inf or NaN always fail,
+// as do rows whose squared terms overflow the words of the check.
+//
+// Float products are checked on the host in double. With two trials and
+// inner of 2000 to 3000, that catches a 10% error in a random element of
+// signed N(0, 1) data every time, a 1% error in about 94% of runs and a
+// 0.1% error in under 40%; the misses are mostly elements near zero. At
+// least the root mean square of its row, an element off by 0.1% is caught
+// about 95% of the time, and any element of uniform positive data every
+// time. The device sums in float, which makes its check about twice as
+// loose.
+//
+// With normwise, every row is measured against the largest row of
+// |A| |B| |r| instead. Strassen's results need this, since their error is
+// bounded only by the norms of A and B; it lets much larger errors pass in
+// rows of small magnitude.
+//
+// Matrix checks the products of multiplyOpenCL, multiplyOpenCLAsync and
+// multiplyOpenCLBatch (in MatrixFuture::get), GemmExpr::evaluateOpenCL
+// for a plain product, multiplyStrassen, multiplyHybrid and
+// multiplyMultiDevice when PHY250_VERIFY is set. gemmBatchedOpenCL and the
+// fused expressions are not checked.
+const int defaultVerifyTrials = 2;
+
+// Trials for the automatic checks of Matrix multiplies, from PHY250_VERIFY.
+// 0, the default, turns them off.
+int verifyTrialsFromEnvironment();
+
+// Reports the rows of C = A * B that failed verification in method and
+// recomputes them on the host
+template <typename T, typename Acc>
+void repairRows(const char* method, const std::vector<int>& failed, int inner, int cols,
+                const T* A, int strideA,
+                const T* B, int strideB,
+                Acc* C, int strideC);
+
+// Checks C = A * B on the host, with matrices laid out as in gemmCPU.
+// Returns the rows of C that failed any trial, in order; empty if C is
+// correct. Instantiated for the same types as gemmCPU.
+template <typename T, typename Acc>
+std::vector<int> verifyGemmCPU(int rows, int inner, int cols,
+                               const T* A, int strideA,
+                               const T* B, int strideB,
+                               const Acc* C, int strideC,
+                               int trials, bool normwise = false);
+
+// Same check on the OpenCL device for matrices already in device buffers,
+// as in enqueueGemm. Only the rows x trials results come back to the host.
+// Returns false if the device could not run the check, leaving
+// mismatchedRows untouched.
+template <typename T, typename Acc>
+bool verifyGemmOpenCL(int rows, int inner, int cols,
+                      cl_mem bufferA, int strideA,
+                      cl_mem bufferB, int strideB,
+                      cl_mem bufferC, int strideC,
+                      int trials, bool normwise, std::vector<int>& mismatchedRows);
+
+#endif // VERIFY_HPP